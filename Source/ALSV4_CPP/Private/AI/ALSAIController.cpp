@@ -3,10 +3,217 @@
 
 #include "AI/ALSAIController.h"
 
+#include "AI/ALSBehaviorTreeComponent.h"
 #include "Character/ALSBaseCharacter.h"
+#include "GameFramework/PlayerController.h"
+#include "Library/ALSStats.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Subsystems/ALSTargetSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI Significance Update"), STAT_ALS_AISignificanceUpdate, STATGROUP_ALS);
 
 AALSAIController::AALSAIController()
 {
+	// RunBehaviorTree reuses the existing brain component
+	BrainComponent = CreateDefaultSubobject<UALSBehaviorTreeComponent>(TEXT("BTComponent"));
+
+	MediumSignificanceRates.BehaviorTreeInterval = 0.1f;
+	MediumSignificanceRates.FocusInterval = 0.1f;
+	MediumSignificanceRates.PathFollowingInterval = 0.1f;
+
+	LowSignificanceRates.BehaviorTreeInterval = 0.5f;
+	LowSignificanceRates.FocusInterval = 0.25f;
+	LowSignificanceRates.PathFollowingInterval = 0.25f;
+}
+
+static void ChangeSignificanceStat(EALSSignificanceTier Tier, int32 Delta)
+{
+	switch (Tier)
+	{
+	case EALSSignificanceTier::High:
+		INC_DWORD_STAT_BY(STAT_ALS_HighSignificanceAI, Delta);
+		break;
+	case EALSSignificanceTier::Medium:
+		INC_DWORD_STAT_BY(STAT_ALS_MediumSignificanceAI, Delta);
+		break;
+	case EALSSignificanceTier::Low:
+		INC_DWORD_STAT_BY(STAT_ALS_LowSignificanceAI, Delta);
+		break;
+	}
+}
+
+void AALSAIController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bUseSignificanceLOD)
+	{
+		ChangeSignificanceStat(SignificanceTier, 1);
+
+		// Spread the tier updates of controllers spawned in the same frame
+		TimeSinceSignificanceUpdate = FMath::FRand() * SignificanceUpdateInterval;
+	}
+}
+
+void AALSAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bUseSignificanceLOD)
+	{
+		ChangeSignificanceStat(SignificanceTier, -1);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AALSAIController::Tick(float DeltaTime)
+{
+	ALS_SCOPED_STAGE_TIMING(AI);
+
+	if (bUseSignificanceLOD && GetPawn())
+	{
+		TimeSinceSignificanceUpdate += DeltaTime;
+		if (TimeSinceSignificanceUpdate >= SignificanceUpdateInterval)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ALS_AISignificanceUpdate);
+			TimeSinceSignificanceUpdate = 0.0f;
+			SetSignificanceTier(GetDesiredSignificanceTier());
+		}
+	}
+
+	Super::Tick(DeltaTime);
+}
+
+void AALSAIController::UpdateControlRotation(float DeltaTime, bool bUpdatePawn)
+{
+	const float FocusInterval = SignificanceTier == EALSSignificanceTier::Low
+		                            ? LowSignificanceRates.FocusInterval
+		                            : SignificanceTier == EALSSignificanceTier::Medium
+		                            ? MediumSignificanceRates.FocusInterval
+		                            : HighSignificanceRates.FocusInterval;
+
+	SkippedFocusDeltaTime += DeltaTime;
+	if (bUseSignificanceLOD && SkippedFocusDeltaTime < FocusInterval)
+	{
+		return;
+	}
+
+	const float FocusDeltaTime = SkippedFocusDeltaTime;
+	SkippedFocusDeltaTime = 0.0f;
+	Super::UpdateControlRotation(FocusDeltaTime, bUpdatePawn);
+}
+
+void AALSAIController::SetSignificanceTier(EALSSignificanceTier NewTier)
+{
+	if (SignificanceTier == NewTier)
+	{
+		return;
+	}
+
+	if (bUseSignificanceLOD)
+	{
+		ChangeSignificanceStat(SignificanceTier, -1);
+		ChangeSignificanceStat(NewTier, 1);
+	}
+
+	SignificanceTier = NewTier;
+	ApplyUpdateRates();
+
+	if (AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(GetPawn()))
+	{
+		ALSCharacter->SetSignificanceTier(SignificanceTier);
+	}
+}
+
+void AALSAIController::SetUseSignificanceLOD(bool bNewUseSignificanceLOD)
+{
+	if (bUseSignificanceLOD == bNewUseSignificanceLOD)
+	{
+		return;
+	}
+
+	// Before BeginPlay only the flag changes, BeginPlay counts the tier
+	if (!bNewUseSignificanceLOD)
+	{
+		SetSignificanceTier(EALSSignificanceTier::High);
+		if (HasActorBegunPlay())
+		{
+			ChangeSignificanceStat(SignificanceTier, -1);
+		}
+		bUseSignificanceLOD = false;
+		return;
+	}
+
+	bUseSignificanceLOD = true;
+	if (HasActorBegunPlay())
+	{
+		ChangeSignificanceStat(SignificanceTier, 1);
+
+		// Pick the tier on the next tick
+		TimeSinceSignificanceUpdate = SignificanceUpdateInterval;
+	}
+}
+
+EALSSignificanceTier AALSAIController::GetDesiredSignificanceTier() const
+{
+	const FVector PawnLocation = GetPawn()->GetActorLocation();
+
+	float ClosestDistSq = TNumericLimits<float>::Max();
+	bool bHasViewer = false;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (Controller)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(ViewLocation, PawnLocation));
+			bHasViewer = true;
+		}
+	}
+
+	if (!bHasViewer)
+	{
+		// No viewers (e.g. headless runs), keep full rate so results match runs without the LOD
+		return EALSSignificanceTier::High;
+	}
+
+	// Apply the buffer only for promotion, so a pawn on the tier boundary doesn't keep swapping rates.
+	const float MediumDist = SignificanceTier != EALSSignificanceTier::High
+		                         ? MediumSignificanceDistance - SignificanceDistanceBuffer
+		                         : MediumSignificanceDistance;
+	const float LowDist = SignificanceTier == EALSSignificanceTier::Low
+		                      ? LowSignificanceDistance - SignificanceDistanceBuffer
+		                      : LowSignificanceDistance;
+
+	if (ClosestDistSq > FMath::Square(LowDist))
+	{
+		return EALSSignificanceTier::Low;
+	}
+	if (ClosestDistSq > FMath::Square(MediumDist))
+	{
+		return EALSSignificanceTier::Medium;
+	}
+	return EALSSignificanceTier::High;
+}
+
+void AALSAIController::ApplyUpdateRates()
+{
+	const FALSAIUpdateRates& Rates = SignificanceTier == EALSSignificanceTier::Low
+		                                 ? LowSignificanceRates
+		                                 : SignificanceTier == EALSSignificanceTier::Medium
+		                                 ? MediumSignificanceRates
+		                                 : HighSignificanceRates;
+
+	if (UALSBehaviorTreeComponent* BehaviorTreeComponent = Cast<UALSBehaviorTreeComponent>(BrainComponent))
+	{
+		BehaviorTreeComponent->SetMinTickInterval(Rates.BehaviorTreeInterval);
+	}
+
+	if (UPathFollowingComponent* PathFollowing = GetPathFollowingComponent())
+	{
+		PathFollowing->SetComponentTickInterval(Rates.PathFollowingInterval);
+	}
 }
 
 void AALSAIController::OnPossess(APawn* InPawn)
@@ -17,6 +224,22 @@ void AALSAIController::OnPossess(APawn* InPawn)
 	{
 		RunBehaviorTree(Behaviour);
 	}
+
+	if (AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(InPawn))
+	{
+		ALSCharacter->SetSignificanceTier(SignificanceTier);
+	}
+}
+
+void AALSAIController::OnUnPossess()
+{
+	// Released pawns go back to full rate, e.g. when returned to the character pool
+	if (AALSBaseCharacter* ALSCharacter = Cast<AALSBaseCharacter>(GetPawn()))
+	{
+		ALSCharacter->SetSignificanceTier(EALSSignificanceTier::High);
+	}
+
+	Super::OnUnPossess();
 }
 
 FVector AALSAIController::GetFocalPointOnActor(const AActor* Actor) const
@@ -28,7 +251,11 @@ FVector AALSAIController::GetFocalPointOnActor(const AActor* Actor) const
 	const APawn* FocusPawn = Cast<APawn>(Actor);
 	if (FocusPawn)
 	{
-		// Focus on pawn's eye view point
+		// Focus on pawn's eye view point, cached once per frame for registered targets
+		if (const UALSTargetSubsystem* TargetSubsystem = GetWorld()->GetSubsystem<UALSTargetSubsystem>())
+		{
+			return TargetSubsystem->GetFocalPoint(FocusPawn);
+		}
 		return FocusPawn->GetPawnViewLocation();
 	}
 	return Actor->GetActorLocation();
@@ -0,0 +1,23 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "AI/ALSBehaviorTreeComponent.h"
+
+#include "Library/ALSStats.h"
+
+void UALSBehaviorTreeComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+                                              FActorComponentTickFunction* ThisTickFunction)
+{
+	ALS_SCOPED_STAGE_TIMING(AI);
+
+	SkippedDeltaTime += DeltaTime;
+	if (SkippedDeltaTime < MinTickInterval)
+	{
+		return;
+	}
+
+	const float TreeDeltaTime = SkippedDeltaTime;
+	SkippedDeltaTime = 0.0f;
+	Super::TickComponent(TreeDeltaTime, TickType, ThisTickFunction);
+}
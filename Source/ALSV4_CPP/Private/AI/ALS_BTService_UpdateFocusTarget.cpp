@@ -0,0 +1,82 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#include "AI/ALS_BTService_UpdateFocusTarget.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Subsystems/ALSTargetSubsystem.h"
+
+UALS_BTService_UpdateFocusTarget::UALS_BTService_UpdateFocusTarget()
+{
+	NodeName = "Update Focus Target";
+
+	// Target selection doesn't need to follow every frame, spread the agents over time instead
+	Interval = 0.5f;
+	RandomDeviation = 0.1f;
+	bNotifyBecomeRelevant = true;
+	bNotifyCeaseRelevant = true;
+
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UALS_BTService_UpdateFocusTarget, BlackboardKey),
+	                              APawn::StaticClass());
+	BlackboardKey.AllowNoneAsValue(true);
+}
+
+void UALS_BTService_UpdateFocusTarget::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+	UpdateFocusTarget(OwnerComp);
+}
+
+void UALS_BTService_UpdateFocusTarget::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	if (AAIController* AIController = OwnerComp.GetAIOwner())
+	{
+		AIController->ClearFocus(EAIFocusPriority::Gameplay);
+	}
+
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+}
+
+void UALS_BTService_UpdateFocusTarget::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory,
+                                                float DeltaSeconds)
+{
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+	UpdateFocusTarget(OwnerComp);
+}
+
+void UALS_BTService_UpdateFocusTarget::UpdateFocusTarget(UBehaviorTreeComponent& OwnerComp) const
+{
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	UALSTargetSubsystem* TargetSubsystem = GetWorld()->GetSubsystem<UALSTargetSubsystem>();
+	const APawn* Pawn = AIController ? AIController->GetPawn() : nullptr;
+	if (!Pawn || !TargetSubsystem)
+	{
+		return;
+	}
+
+	APawn* Target = TargetSubsystem->FindNearestTarget(Pawn->GetActorLocation(), MaxDistance, TargetType, Pawn);
+	if (Target != AIController->GetFocusActorForPriority(EAIFocusPriority::Gameplay))
+	{
+		if (Target)
+		{
+			AIController->SetFocus(Target);
+		}
+		else
+		{
+			AIController->ClearFocus(EAIFocusPriority::Gameplay);
+		}
+	}
+
+	if (BlackboardKey.SelectedKeyName != NAME_None)
+	{
+		OwnerComp.GetBlackboardComponent()->SetValueAsObject(BlackboardKey.SelectedKeyName, Target);
+	}
+}
+
+FString UALS_BTService_UpdateFocusTarget::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("%s\nFocus nearest %s\nMax Distance: %d"), *Super::GetStaticDescription(),
+	                       *StaticEnum<EALSFocusTargetType>()->GetNameStringByValue(static_cast<int64>(TargetType)),
+	                       FMath::RoundToInt(MaxDistance));
+}
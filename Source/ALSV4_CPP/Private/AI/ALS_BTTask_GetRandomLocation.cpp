@@ -5,6 +5,7 @@
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "Subsystems/ALSNavQuerySubsystem.h"
 
 UALS_BTTask_GetRandomLocation::UALS_BTTask_GetRandomLocation()
 {
@@ -15,38 +16,78 @@ UALS_BTTask_GetRandomLocation::UALS_BTTask_GetRandomLocation()
 
 EBTNodeResult::Type UALS_BTTask_GetRandomLocation::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
-	UWorld* World = GetWorld();
-	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	FALSBTGetRandomLocationMemory* Memory = CastInstanceNodeMemory<FALSBTGetRandomLocationMemory>(NodeMemory);
+	Memory->RequestId = 0;
+
+	UALSNavQuerySubsystem* NavQuerySubsystem = GetWorld()->GetSubsystem<UALSNavQuerySubsystem>();
 	APawn* Pawn = OwnerComp.GetAIOwner()->GetPawn();
 
-	if (NavSys && Pawn)
+	if (NavQuerySubsystem && Pawn)
 	{
-		FSharedConstNavQueryFilter SharedFilter = nullptr;
+		const FVector Origin = Pawn->GetActorLocation();
 
-		if (Filter)
+		FVector Destination;
+		if (bUsePointPool && NavQuerySubsystem->TryGetPooledPoint(Origin, MaxDistance, Filter, Destination))
 		{
-			const ANavigationData* NavData = NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate);
-			if (NavData)
-			{
-				SharedFilter = UNavigationQueryFilter::GetQueryFilter(*NavData, World, Filter);
-			}
+			OwnerComp.GetBlackboardComponent()->SetValueAsVector(BlackboardKey.SelectedKeyName, Destination);
+			return EBTNodeResult::Succeeded;
 		}
 
-		const FVector Origin = Pawn->GetActorLocation();
-		FNavLocation Destination;
+		// The query runs within the subsystem's per frame budget and finishes this task from its callback
+		Memory->RequestId = NavQuerySubsystem->RequestRandomReachablePoint(
+			Origin, MaxDistance, Filter, bUsePointPool,
+			FALSRandomLocationDelegate::CreateUObject(this, &UALS_BTTask_GetRandomLocation::OnQueryFinished,
+			                                          TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+		return EBTNodeResult::InProgress;
+	}
+
+	return EBTNodeResult::Failed;
+}
 
-		if (NavSys->GetRandomReachablePointInRadius(Origin, MaxDistance, Destination, nullptr, SharedFilter))
+void UALS_BTTask_GetRandomLocation::OnQueryFinished(bool bSuccess, const FVector& Location,
+                                                    TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	if (bSuccess)
+	{
+		OwnerComp->GetBlackboardComponent()->SetValueAsVector(BlackboardKey.SelectedKeyName, Location);
+	}
+
+	if (uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this)))
+	{
+		CastInstanceNodeMemory<FALSBTGetRandomLocationMemory>(NodeMemory)->RequestId = 0;
+	}
+
+	FinishLatentTask(*OwnerComp, bSuccess ? EBTNodeResult::Succeeded : EBTNodeResult::Failed);
+}
+
+EBTNodeResult::Type UALS_BTTask_GetRandomLocation::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	FALSBTGetRandomLocationMemory* Memory = CastInstanceNodeMemory<FALSBTGetRandomLocationMemory>(NodeMemory);
+	if (Memory->RequestId != 0)
+	{
+		if (UALSNavQuerySubsystem* NavQuerySubsystem = GetWorld()->GetSubsystem<UALSNavQuerySubsystem>())
 		{
-			OwnerComp.GetBlackboardComponent()->SetValueAsVector(BlackboardKey.SelectedKeyName, Destination.Location);
-			return EBTNodeResult::Succeeded;
+			NavQuerySubsystem->CancelRequest(Memory->RequestId);
 		}
+		Memory->RequestId = 0;
 	}
 
-	return EBTNodeResult::Failed;
+	return EBTNodeResult::Aborted;
+}
+
+uint16 UALS_BTTask_GetRandomLocation::GetInstanceMemorySize() const
+{
+	return sizeof(FALSBTGetRandomLocationMemory);
 }
 
 FString UALS_BTTask_GetRandomLocation::GetStaticDescription() const
 {
-	return FString::Printf(TEXT("Get Random Location\nMax Distance: %d\nFilter:%s"), FMath::RoundToInt(MaxDistance),
-	                       Filter ? *GetNameSafe(Filter.Get()) : TEXT("None"));
+	return FString::Printf(TEXT("Get Random Location\nMax Distance: %d\nFilter:%s%s"), FMath::RoundToInt(MaxDistance),
+	                       Filter ? *GetNameSafe(Filter.Get()) : TEXT("None"),
+	                       bUsePointPool ? TEXT("\nUses Point Pool") : TEXT(""));
 }
@@ -0,0 +1,103 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Character/ALSActionAssets.h"
+
+#include "Animation/AnimMontage.h"
+#include "Character/ALSBaseCharacter.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+namespace ALSActionAssets
+{
+	/* Bytes of the loaded assets in the paths, montages include the sequences they play*/
+	static int64 GetLoadedBytes(const TArray<FSoftObjectPath>& Paths, TSet<const UObject*>& CountedObjects)
+	{
+		int64 Bytes = 0;
+		const auto AddObject = [&Bytes, &CountedObjects](const UObject* Object)
+		{
+			bool bAlreadyCounted = false;
+			CountedObjects.Add(Object, &bAlreadyCounted);
+			if (!bAlreadyCounted)
+			{
+				Bytes += Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			}
+		};
+
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			const UObject* Object = Path.ResolveObject();
+			if (!Object)
+			{
+				continue;
+			}
+
+			AddObject(Object);
+			if (const UAnimMontage* Montage = Cast<UAnimMontage>(Object))
+			{
+				for (const FSlotAnimationTrack& Slot : Montage->SlotAnimTracks)
+				{
+					for (const FAnimSegment& Segment : Slot.AnimTrack.AnimSegments)
+					{
+						if (const UAnimSequenceBase* Sequence = Segment.GetAnimReference())
+						{
+							AddObject(Sequence);
+						}
+					}
+				}
+			}
+		}
+		return Bytes;
+	}
+
+	static void LogMemoryReport(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		for (TActorIterator<AALSBaseCharacter> It(World); It; ++It)
+		{
+			const AALSBaseCharacter* Character = *It;
+			const UALSActionAssets* ActionAssets = Character->GetActionAssets();
+			if (!ActionAssets)
+			{
+				UE_LOG(LogTemp, Log, TEXT("%s: no action assets, every Blueprint action variant stays loaded"),
+				       *Character->GetName());
+				continue;
+			}
+
+			TArray<FSoftObjectPath> CurrentPaths;
+			ActionAssets->GetActions(Character->GetOverlayState()).GetAssetsToLoad(CurrentPaths);
+
+			TArray<FSoftObjectPath> AllPaths;
+			ActionAssets->DefaultActions.GetAssetsToLoad(AllPaths);
+			for (const TPair<EALSOverlayState, FALSOverlayActionAssets>& Pair : ActionAssets->OverlayActions)
+			{
+				Pair.Value.GetAssetsToLoad(AllPaths);
+			}
+
+			const int32 NumLoaded = AllPaths.FilterByPredicate([](const FSoftObjectPath& Path)
+			{
+				return Path.ResolveObject() != nullptr;
+			}).Num();
+
+			// Assets of other overlay states can be loaded by other characters, count them separately
+			TSet<const UObject*> CountedObjects;
+			const int64 CurrentBytes = GetLoadedBytes(CurrentPaths, CountedObjects);
+			const int64 OtherBytes = GetLoadedBytes(AllPaths, CountedObjects);
+
+			UE_LOG(LogTemp, Log,
+			       TEXT("%s: %s action assets %.1f KB, other overlay states %.1f KB loaded, %d of %d action assets loaded"),
+			       *Character->GetName(), *UEnum::GetDisplayValueAsText(Character->GetOverlayState()).ToString(),
+			       CurrentBytes / 1024.0, OtherBytes / 1024.0, NumLoaded, AllPaths.Num());
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdMemoryReport(
+		TEXT("ALS.Actions.MemoryReport"),
+		TEXT("Log the loaded mantle, roll and get up animation bytes of each ALS character."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&LogMemoryReport));
+}
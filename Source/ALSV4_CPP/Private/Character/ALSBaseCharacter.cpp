@@ -7,17 +7,34 @@
 
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
+#include "Character/ALSActionAssets.h"
+#include "Character/ALSMeshRegistry.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSLocomotionCore.h"
+#include "Library/ALSStats.h"
+#include "Library/ALSTrace.h"
 #include "Components/ALSDebugComponent.h"
+#include "Components/ALSMantleComponent.h"
+#include "Subsystems/ALSRagdollLODSubsystem.h"
+#include "Subsystems/ALSSceneQuerySubsystem.h"
+#include "Subsystems/ALSTargetSubsystem.h"
 
 #include "Components/CapsuleComponent.h"
 #include "Curves/CurveFloat.h"
+#include "Engine/AssetManager.h"
 #include "Character/ALSCharacterMovementComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Tick"), STAT_ALS_CharacterTick, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Character Essential Values"), STAT_ALS_EssentialValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Character Movement And Rotation"), STAT_ALS_CharacterRotation, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Ragdoll Update"), STAT_ALS_RagdollUpdate, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Action Asset Sync Loads"), STAT_ALS_ActionAssetSyncLoads, STATGROUP_ALS);
 
 
 const FName NAME_FP_Camera(TEXT("FP_Camera"));
@@ -49,7 +66,8 @@ void AALSBaseCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(AALSBaseCharacter, TargetRagdollLocation);
+	// Paused in PreReplication while the ragdoll is settled
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, TargetRagdollLocation, COND_Custom);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedCurrentAcceleration, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ReplicatedControlRotation, COND_SkipOwner);
 
@@ -61,11 +79,93 @@ void AALSBaseCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& Ou
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, OverlayState, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, ViewMode, COND_SkipOwner);
 	DOREPLIFETIME_CONDITION(AALSBaseCharacter, VisibleMesh, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(AALSBaseCharacter, VisibleMeshId, COND_SkipOwner);
+}
+
+void AALSBaseCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// Settled ragdolls don't move, no need to keep their location in replication
+	DOREPLIFETIME_ACTIVE_OVERRIDE(AALSBaseCharacter, TargetRagdollLocation, !bRagdollSettled);
+}
+
+void AALSBaseCharacter::ResetALSState()
+{
+	// Leave the ragdoll without the pose snapshot and get up montage of RagdollEnd
+	if (MovementState == EALSMovementState::Ragdoll)
+	{
+		RagdollRestoreSettings();
+		RagdollRestorePhysics();
+		if (RagdollStateChangedDelegate.IsBound())
+		{
+			RagdollStateChangedDelegate.Broadcast(false);
+		}
+	}
+
+	if (UALSMantleComponent* MantleComponent = FindComponentByClass<UALSMantleComponent>())
+	{
+		MantleComponent->ResetMantle();
+	}
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+	{
+		AnimInstance->Montage_Stop(0.0f);
+		if (UALSCharacterAnimInstance* ALSAnimInstance = Cast<UALSCharacterAnimInstance>(AnimInstance))
+		{
+			ALSAnimInstance->ResetAnimationValues();
+		}
+	}
+
+	GetWorldTimerManager().ClearTimer(OnLandedFrictionResetTimer);
+	GetCharacterMovement()->BrakingFrictionFactor = 0.0f;
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	// Desired values may have been changed by input during the previous life, start from the class defaults
+	const AALSBaseCharacter* Defaults = GetClass()->GetDefaultObject<AALSBaseCharacter>();
+	DesiredGait = Defaults->DesiredGait;
+	DesiredStance = Defaults->DesiredStance;
+	DesiredRotationMode = Defaults->DesiredRotationMode;
+	ViewMode = Defaults->ViewMode;
+	OverlayState = Defaults->OverlayState;
+	MovementAction = EALSMovementAction::None;
+	bBreakFall = false;
+	bSprintHeld = false;
+	ForceUpdateCharacterState();
+
+	if (Stance == EALSStance::Standing)
+	{
+		UnCrouch();
+	}
+	else if (Stance == EALSStance::Crouching)
+	{
+		Crouch();
+	}
+
+	// Same rotation values as BeginPlay, facing the new actor rotation.
+	TargetRotation = GetActorRotation();
+	InAirRotation = TargetRotation;
+	LastVelocityRotation = TargetRotation;
+	LastMovementInputRotation = TargetRotation;
+	AimingRotation = GetControlRotation();
+	PreviousVelocity = FVector::ZeroVector;
+	PreviousAimYaw = AimingRotation.Yaw;
+	Acceleration = FVector::ZeroVector;
+	Speed = 0.0f;
+	bIsMoving = false;
+	bHasMovementInput = false;
+	MovementInputAmount = 0.0f;
+	AimYawRate = 0.0f;
+	BakedTurnTime = -1.0f;
+	BakedTurnDelayTime = 0.0f;
+
+	MyCharacterMovementComponent->SetMovementSettings(GetTargetMovementSettings());
 }
 
 void AALSBaseCharacter::OnBreakfall_Implementation()
 {
-	Replicated_PlayMontage(GetRollAnimation(), 1.35);
+	Replicated_PlayMontage(FindRollAnimation(), 1.35);
 }
 
 void AALSBaseCharacter::Replicated_PlayMontage_Implementation(UAnimMontage* Montage, float PlayRate)
@@ -89,8 +189,9 @@ void AALSBaseCharacter::BeginPlay()
 	// Make sure the mesh and animbp update after the CharacterBP to ensure it gets the most recent values.
 	GetMesh()->AddTickPrerequisiteActor(this);
 
-	// Set the Movement Model
+	// Set the Movement Model, shared with other characters using the same row
 	SetMovementModel();
+	FALSMovementModelCache::OnMovementModelsInvalidated().AddUObject(this, &AALSBaseCharacter::OnMovementModelsInvalidated);
 
 	// Force update states to use the initial desired values.
 	ForceUpdateCharacterState();
@@ -116,28 +217,84 @@ void AALSBaseCharacter::BeginPlay()
 
 	MyCharacterMovementComponent->SetMovementSettings(GetTargetMovementSettings());
 
+	// Dedicated server can drive the rotation from baked curves, so the anim graph doesn't need to tick.
+	// Ragdoll still switches to always tick pose, and restores this option on ragdoll end.
+	bUsingBakedCurves = bUseBakedCurvesOnServer && BakedYawOffsetCurve && BakedTurnInPlaceCurve &&
+		UKismetSystemLibrary::IsDedicatedServer(GetWorld());
+	if (bUsingBakedCurves)
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	}
+
 	ALSDebugComponent = FindComponentByClass<UALSDebugComponent>();
+
+	if (UALSTargetSubsystem* TargetSubsystem = GetWorld()->GetSubsystem<UALSTargetSubsystem>())
+	{
+		TargetSubsystem->RegisterTarget(this);
+	}
 }
 
-void AALSBaseCharacter::Tick(float DeltaTime)
+void AALSBaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	if (UALSTargetSubsystem* TargetSubsystem = GetWorld()->GetSubsystem<UALSTargetSubsystem>())
+	{
+		TargetSubsystem->UnregisterTarget(this);
+	}
 
-	// Set required values
-	SetEssentialValues(DeltaTime);
+	// The cache outlives the world, don't leave a binding behind for each destroyed character
+	FALSMovementModelCache::OnMovementModelsInvalidated().RemoveAll(this);
 
-	if (MovementState == EALSMovementState::Grounded)
+	if (ActionAssetsHandle.IsValid())
 	{
-		UpdateCharacterMovement();
-		UpdateGroundedRotation(DeltaTime);
+		ActionAssetsHandle->ReleaseHandle();
+		ActionAssetsHandle.Reset();
 	}
-	else if (MovementState == EALSMovementState::InAir)
+
+	StateEvent.Clear();
+	StateEventListeners.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AALSBaseCharacter::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CharacterTick);
+	CSV_SCOPED_TIMING_STAT(ALS, CharacterTick);
+	ALS_SCOPED_STAGE_TIMING(CharacterTick);
+
+	// Set required values
 	{
-		UpdateInAirRotation(DeltaTime);
+		SCOPE_CYCLE_COUNTER(STAT_ALS_EssentialValues);
+		SetEssentialValues(DeltaTime);
 	}
-	else if (MovementState == EALSMovementState::Ragdoll)
+
 	{
-		RagdollUpdate(DeltaTime);
+		// Rotation and ragdoll follow may move the actor several times per frame. Defer the transform
+		// propagation to attached components and overlap updates so they run once at the end of the scope.
+		const EScopedUpdate::Type UpdateMode = bDeferTransformUpdates
+			                                       ? EScopedUpdate::DeferredUpdates
+			                                       : EScopedUpdate::ImmediateUpdates;
+		FScopedMovementUpdate ScopedMovementUpdate(GetCapsuleComponent(), UpdateMode);
+
+		if (MovementState == EALSMovementState::Grounded)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ALS_CharacterRotation);
+			UpdateCharacterMovement();
+			UpdateGroundedRotation(DeltaTime);
+		}
+		else if (MovementState == EALSMovementState::InAir)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ALS_CharacterRotation);
+			UpdateInAirRotation(DeltaTime);
+		}
+		else if (MovementState == EALSMovementState::Ragdoll)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ALS_RagdollUpdate);
+			ALS_SCOPED_STAGE_TIMING(Ragdoll);
+			RagdollUpdate(DeltaTime);
+		}
 	}
 
 	// Cache values
@@ -161,24 +318,37 @@ void AALSBaseCharacter::RagdollStart()
 		DefVisBasedTickOp = GetMesh()->VisibilityBasedAnimTickOption;
 		GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
 	}
-	TargetRagdollLocation = GetMesh()->GetSocketLocation(NAME_Pelvis);
+	TargetRagdollLocation = BoneIndexCache.GetSocketLocation(GetMesh(), NAME_Pelvis);
 	ServerRagdollPull = 0;
+	bRagdollSettled = false;
+	RagdollSettleFrames = 0;
+	RagdollDriveSpringStep = INDEX_NONE;
 
-	// Disable URO
+	// Disable URO and the significance tick interval
 	bPreRagdollURO = GetMesh()->bEnableUpdateRateOptimizations;
 	GetMesh()->bEnableUpdateRateOptimizations = false;
+	GetMesh()->SetComponentTickInterval(0.0f);
 
 	// Step 1: Clear the Character Movement Mode and set the Movement State to Ragdoll
 	GetCharacterMovement()->SetMovementMode(MOVE_None);
 	SetMovementState(EALSMovementState::Ragdoll);
 
-	// Step 2: Disable capsule collision and enable mesh physics simulation starting from the pelvis.
+	// Step 2: Pick the ragdoll LOD and swap the physics asset before simulation starts.
+	PreRagdollPhysicsAsset = GetMesh()->GetPhysicsAsset();
+	RagdollLOD = EALSRagdollLOD::Full;
+	if (UALSRagdollLODSubsystem* RagdollLODSubsystem = GetWorld()->GetSubsystem<UALSRagdollLODSubsystem>())
+	{
+		SetRagdollLOD(RagdollLODSubsystem->RegisterRagdoll(this));
+	}
+	ALS_TRACE_STATE_TRANSITION(this, EALSTraceTransition::RagdollStart, 0, RagdollLOD);
+
+	// Step 3: Disable capsule collision and enable mesh physics simulation starting from the pelvis.
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	GetMesh()->SetCollisionObjectType(ECC_PhysicsBody);
 	GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 	GetMesh()->SetAllBodiesBelowSimulatePhysics(NAME_Pelvis, true, true);
 
-	// Step 3: Stop any active montages.
+	// Step 4: Stop any active montages.
 	if (GetMesh()->GetAnimInstance())
 	{
 		GetMesh()->GetAnimInstance()->Montage_Stop(0.2f);
@@ -192,20 +362,9 @@ void AALSBaseCharacter::RagdollStart()
 
 void AALSBaseCharacter::RagdollEnd()
 {
-	/** Re-enable Replicate Movement and if the host is a dedicated server set mesh visibility based anim
-	tick option back to default*/
-
-	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
-	{
-		GetMesh()->VisibilityBasedAnimTickOption = DefVisBasedTickOp;
-	}
+	ALS_TRACE_STATE_TRANSITION(this, EALSTraceTransition::RagdollEnd, RagdollLOD, 0);
 
-	GetMesh()->bEnableUpdateRateOptimizations = bPreRagdollURO;
-
-	// Revert back to default settings
-	MyCharacterMovementComponent->bIgnoreClientMovementErrorChecksAndCorrection = 0;
-	GetMesh()->bOnlyAllowAutonomousTickPose = false;
-	SetReplicateMovement(true);
+	RagdollRestoreSettings();
 
 	// Step 1: Save a snapshot of the current Ragdoll Pose for use in AnimGraph to blend out of the ragdoll
 	if (GetMesh()->GetAnimInstance())
@@ -220,7 +379,7 @@ void AALSBaseCharacter::RagdollEnd()
 		GetCharacterMovement()->SetMovementMode(MOVE_Walking);
 		if (GetMesh()->GetAnimInstance())
 		{
-			GetMesh()->GetAnimInstance()->Montage_Play(GetGetUpAnimation(bRagdollFaceUp), 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
+			GetMesh()->GetAnimInstance()->Montage_Play(FindGetUpAnimation(bRagdollFaceUp), 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, true);
 		}
 	}
 	else
@@ -229,16 +388,143 @@ void AALSBaseCharacter::RagdollEnd()
 		GetCharacterMovement()->Velocity = LastRagdollVelocity;
 	}
 
-	// Step 3: Re-Enable capsule collision, and disable physics simulation on the mesh.
+	// Step 3: Re-Enable capsule collision, disable physics simulation on the mesh and restore the physics asset.
+	RagdollRestorePhysics();
+
+	if (RagdollStateChangedDelegate.IsBound())
+	{
+		RagdollStateChangedDelegate.Broadcast(false);
+	}
+}
+
+void AALSBaseCharacter::RagdollRestoreSettings()
+{
+	/** Re-enable Replicate Movement and if the host is a dedicated server set mesh visibility based anim
+	tick option back to default*/
+
+	if (UKismetSystemLibrary::IsDedicatedServer(GetWorld()))
+	{
+		GetMesh()->VisibilityBasedAnimTickOption = DefVisBasedTickOp;
+	}
+
+	GetMesh()->bEnableUpdateRateOptimizations = bPreRagdollURO;
+	ApplySignificanceTier();
+
+	bRagdollSettled = false;
+	RagdollSettleFrames = 0;
+
+	// Revert back to default settings
+	MyCharacterMovementComponent->bIgnoreClientMovementErrorChecksAndCorrection = 0;
+	GetMesh()->bOnlyAllowAutonomousTickPose = false;
+	SetReplicateMovement(true);
+}
+
+void AALSBaseCharacter::RagdollRestorePhysics()
+{
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 	GetMesh()->SetCollisionObjectType(ECC_Pawn);
 	GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 	GetMesh()->SetAllBodiesSimulatePhysics(false);
 
-	if (RagdollStateChangedDelegate.IsBound())
+	// Restore the physics asset used before the ragdoll LOD swap.
+	if (UALSRagdollLODSubsystem* RagdollLODSubsystem = GetWorld()->GetSubsystem<UALSRagdollLODSubsystem>())
 	{
-		RagdollStateChangedDelegate.Broadcast(false);
+		RagdollLODSubsystem->UnregisterRagdoll(this);
+	}
+	if (PreRagdollPhysicsAsset && GetMesh()->GetPhysicsAsset() != PreRagdollPhysicsAsset)
+	{
+		GetMesh()->SetPhysicsAsset(PreRagdollPhysicsAsset, true);
+	}
+	PreRagdollPhysicsAsset = nullptr;
+	RagdollLOD = EALSRagdollLOD::Full;
+}
+
+void AALSBaseCharacter::SetSignificanceTier(EALSSignificanceTier NewTier)
+{
+	if (SignificanceTier != NewTier)
+	{
+		const EALSSignificanceTier Prev = SignificanceTier;
+		SignificanceTier = NewTier;
+		OnSignificanceTierChanged(Prev);
+	}
+}
+
+void AALSBaseCharacter::ApplySignificanceTier()
+{
+	float MeshTickInterval = 0.0f;
+	float QueryScale = 1.0f;
+	if (SignificanceTier == EALSSignificanceTier::Medium)
+	{
+		MeshTickInterval = MediumSignificanceMeshTickInterval;
+		QueryScale = MediumSignificanceQueryScale;
+	}
+	else if (SignificanceTier == EALSSignificanceTier::Low)
+	{
+		MeshTickInterval = LowSignificanceMeshTickInterval;
+		QueryScale = LowSignificanceQueryScale;
+	}
+
+	// Ragdoll pose follows the physics bodies, keep it updating every frame
+	if (MovementState != EALSMovementState::Ragdoll)
+	{
+		GetMesh()->SetComponentTickInterval(MeshTickInterval);
+	}
+
+	if (UALSSceneQuerySubsystem* SceneQuerySubsystem = GetWorld()->GetSubsystem<UALSSceneQuerySubsystem>())
+	{
+		SceneQuerySubsystem->SetSignificance(this, QueryScale);
+	}
+}
+
+void AALSBaseCharacter::SetRagdollLOD(EALSRagdollLOD NewLOD)
+{
+	// Outside ragdoll there is no physics asset to restore on ragdoll end, the swap would stick
+	if (MovementState != EALSMovementState::Ragdoll)
+	{
+		return;
+	}
+
+	UPhysicsAsset* NewAsset = PreRagdollPhysicsAsset;
+	if (NewLOD == EALSRagdollLOD::Simple)
+	{
+		NewAsset = SimpleRagdollPhysicsAsset ? SimpleRagdollPhysicsAsset : ReducedRagdollPhysicsAsset;
+	}
+	else if (NewLOD == EALSRagdollLOD::Reduced)
+	{
+		NewAsset = ReducedRagdollPhysicsAsset;
+	}
+
+	RagdollLOD = NewLOD;
+
+	if (!NewAsset)
+	{
+		NewAsset = PreRagdollPhysicsAsset;
+	}
+	if (!NewAsset || GetMesh()->GetPhysicsAsset() == NewAsset)
+	{
+		return;
 	}
+
+	// Swapping the physics asset recreates the bodies, re-enable the simulation and carry the velocity over.
+	const bool bWasSimulating = GetMesh()->IsSimulatingPhysics(NAME_Pelvis);
+	GetMesh()->SetPhysicsAsset(NewAsset, true);
+	RagdollDriveSpringStep = INDEX_NONE;
+	if (bWasSimulating)
+	{
+		GetMesh()->SetAllBodiesBelowSimulatePhysics(NAME_Pelvis, true, true);
+		GetMesh()->SetAllPhysicsLinearVelocity(LastRagdollVelocity);
+	}
+}
+
+void AALSBaseCharacter::SetRagdollDriveSpringSteps(int32 NewSteps)
+{
+	RagdollDriveSpringSteps = FMath::Max(NewSteps, 1);
+	RagdollDriveSpringStep = INDEX_NONE;
+}
+
+void AALSBaseCharacter::SetDeferTransformUpdates(bool bNewDeferTransformUpdates)
+{
+	bDeferTransformUpdates = bNewDeferTransformUpdates;
 }
 
 void AALSBaseCharacter::Server_SetMeshLocationDuringRagdoll_Implementation(FVector MeshLocation)
@@ -252,7 +538,9 @@ void AALSBaseCharacter::SetMovementState(const EALSMovementState NewState, bool
 	{
 		PrevMovementState = MovementState;
 		MovementState = NewState;
+		ALS_TRACE_STATE_TRANSITION(this, EALSTraceTransition::MovementState, PrevMovementState, NewState);
 		OnMovementStateChanged(PrevMovementState);
+		StateEvent.Broadcast(this);
 	}
 }
 
@@ -272,7 +560,9 @@ void AALSBaseCharacter::SetStance(const EALSStance NewStance, bool bForce)
 	{
 		const EALSStance Prev = Stance;
 		Stance = NewStance;
+		ALS_TRACE_STATE_TRANSITION(this, EALSTraceTransition::Stance, Prev, NewStance);
 		OnStanceChanged(Prev);
+		StateEvent.Broadcast(this);
 	}
 }
 
@@ -281,12 +571,29 @@ void AALSBaseCharacter::SetOverlayOverrideState(int32 NewState)
 	OverlayOverrideState = NewState;
 }
 
+void AALSBaseCharacter::AddStateEventListener(const UObject* Listener, int32 InstanceId,
+                                              FCharacterStateEventSignature::FDelegate&& Delegate)
+{
+	RemoveStateEventListener(Listener, InstanceId);
+	StateEventListeners.Add({FObjectKey(Listener), InstanceId}, StateEvent.Add(MoveTemp(Delegate)));
+}
+
+void AALSBaseCharacter::RemoveStateEventListener(const UObject* Listener, int32 InstanceId)
+{
+	FDelegateHandle Handle;
+	if (StateEventListeners.RemoveAndCopyValue({FObjectKey(Listener), InstanceId}, Handle))
+	{
+		StateEvent.Remove(Handle);
+	}
+}
+
 void AALSBaseCharacter::SetGait(const EALSGait NewGait, bool bForce)
 {
 	if (bForce || Gait != NewGait)
 	{
 		const EALSGait Prev = Gait;
 		Gait = NewGait;
+		ALS_TRACE_STATE_TRANSITION(this, EALSTraceTransition::Gait, Prev, NewGait);
 		OnGaitChanged(Prev);
 	}
 }
@@ -340,6 +647,7 @@ void AALSBaseCharacter::SetRotationMode(const EALSRotationMode NewRotationMode,
 	{
 		const EALSRotationMode Prev = RotationMode;
 		RotationMode = NewRotationMode;
+		ALS_TRACE_STATE_TRANSITION(this, EALSTraceTransition::RotationMode, Prev, NewRotationMode);
 		OnRotationModeChanged(Prev);
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
@@ -381,6 +689,7 @@ void AALSBaseCharacter::SetOverlayState(const EALSOverlayState NewState, bool bF
 	{
 		const EALSOverlayState Prev = OverlayState;
 		OverlayState = NewState;
+		ALS_TRACE_STATE_TRANSITION(this, EALSTraceTransition::OverlayState, Prev, NewState);
 		OnOverlayStateChanged(Prev);
 
 		if (GetLocalRole() == ROLE_AutonomousProxy)
@@ -494,11 +803,18 @@ void AALSBaseCharacter::SetActorLocationAndTargetRotation(FVector NewLocation, F
 
 void AALSBaseCharacter::SetMovementModel()
 {
-	const FString ContextString = GetFullName();
-	FALSMovementStateSettings* OutRow =
-		MovementModel.DataTable->FindRow<FALSMovementStateSettings>(MovementModel.RowName, ContextString);
-	check(OutRow);
-	MovementData = *OutRow;
+	MovementData = FALSMovementModelCache::Get(MovementModel);
+	check(MovementData);
+	MovementSettingsIndex = FALSMovementModel::GetSettingsIndex(RotationMode, Stance);
+}
+
+void AALSBaseCharacter::OnMovementModelsInvalidated(const UDataTable* DataTable)
+{
+	if (DataTable == MovementModel.DataTable)
+	{
+		SetMovementModel();
+		MyCharacterMovementComponent->SetMovementSettings(GetTargetMovementSettings());
+	}
 }
 
 void AALSBaseCharacter::ForceUpdateCharacterState()
@@ -514,107 +830,255 @@ void AALSBaseCharacter::ForceUpdateCharacterState()
 
 FALSMovementSettings AALSBaseCharacter::GetTargetMovementSettings() const
 {
-	if (RotationMode == EALSRotationMode::VelocityDirection)
+	return MovementData ? MovementData->GetSettings(MovementSettingsIndex) : FALSMovementSettings();
+}
+
+FALSMovementStateSettings AALSBaseCharacter::GetMovementData() const
+{
+	return MovementData ? MovementData->Settings : FALSMovementStateSettings();
+}
+
+bool AALSBaseCharacter::CanSprint() const
+{
+	// Determine if the character is currently able to sprint based on the Rotation mode and current acceleration
+	// (input) rotation. If the character is in the Looking Rotation mode, only allow sprinting if there is full
+	// movement input and it is faced forward relative to the camera + or - 50 degrees.
+	const float InputAimYawDelta = RotationMode == EALSRotationMode::LookingDirection
+		                               ? (ReplicatedCurrentAcceleration.ToOrientationRotator() - AimingRotation).
+		                               GetNormalized().Yaw
+		                               : 0.0f;
+	return ALSLocomotionCore::CanSprint(bHasMovementInput, MovementInputAmount,
+	                                    static_cast<ALSLocomotionCore::ERotationMode>(RotationMode), InputAimYawDelta);
+}
+
+FVector AALSBaseCharacter::GetMovementInput() const
+{
+	return ReplicatedCurrentAcceleration;
+}
+
+float AALSBaseCharacter::GetAnimCurveValue(FName CurveName) const
+{
+	if (GetMesh()->GetAnimInstance())
+	{
+		return GetMesh()->GetAnimInstance()->GetCurveValue(CurveName);
+	}
+
+	return 0.0f;
+}
+
+void AALSBaseCharacter::SetVisibleMesh(USkeletalMesh* NewVisibleMesh)
+{
+	const uint8 NewMeshId = MeshRegistry
+		                        ? MeshRegistry->FindMeshId(TSoftObjectPtr<USkeletalMesh>(NewVisibleMesh))
+		                        : 0;
+	if (NewMeshId != 0)
 	{
-		if (Stance == EALSStance::Standing)
-		{
-			return MovementData.VelocityDirection.Standing;
-		}
-		if (Stance == EALSStance::Crouching)
-		{
-			return MovementData.VelocityDirection.Crouching;
-		}
+		SetVisibleMeshId(NewMeshId);
+		return;
 	}
-	else if (RotationMode == EALSRotationMode::LookingDirection)
+
+	CancelVisibleMeshLoad();
+	const bool bWasRegistered = VisibleMeshId != 0;
+	VisibleMeshId = 0;
+
+	// VisibleMesh is cleared while a registered mesh is shown, leaving a registered mesh needs the id cleared even
+	// if the new mesh is null
+	if (VisibleMesh != NewVisibleMesh || bWasRegistered)
 	{
-		if (Stance == EALSStance::Standing)
-		{
-			return MovementData.LookingDirection.Standing;
-		}
-		if (Stance == EALSStance::Crouching)
+		VisibleMesh = NewVisibleMesh;
+		ApplyVisibleMesh(NewVisibleMesh);
+
+		if (GetLocalRole() != ROLE_Authority)
 		{
-			return MovementData.LookingDirection.Crouching;
+			Server_SetVisibleMesh(NewVisibleMesh);
 		}
 	}
-	else if (RotationMode == EALSRotationMode::Aiming)
+}
+
+void AALSBaseCharacter::Server_SetVisibleMesh_Implementation(USkeletalMesh* NewVisibleMesh)
+{
+	SetVisibleMesh(NewVisibleMesh);
+}
+
+void AALSBaseCharacter::SetVisibleMeshAsync(TSoftObjectPtr<USkeletalMesh> NewSkeletalMesh)
+{
+	const uint8 NewMeshId = MeshRegistry ? MeshRegistry->FindMeshId(NewSkeletalMesh) : 0;
+	if (NewMeshId != 0)
 	{
-		if (Stance == EALSStance::Standing)
-		{
-			return MovementData.Aiming.Standing;
-		}
-		if (Stance == EALSStance::Crouching)
-		{
-			return MovementData.Aiming.Crouching;
-		}
+		SetVisibleMeshId(NewMeshId);
+		return;
+	}
+
+	CancelVisibleMeshLoad();
+	if (NewSkeletalMesh.IsNull())
+	{
+		SetVisibleMesh(nullptr);
+		return;
 	}
 
-	// Default to velocity dir standing
-	return MovementData.VelocityDirection.Standing;
+	// Not registered, stream it in locally and replicate it by reference once loaded
+	VisibleMeshHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		NewSkeletalMesh.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(this, [this, NewSkeletalMesh]()
+		{
+			VisibleMeshHandle.Reset();
+			SetVisibleMesh(NewSkeletalMesh.Get());
+		}));
 }
 
-bool AALSBaseCharacter::CanSprint() const
+void AALSBaseCharacter::Server_SetVisibleMeshId_Implementation(uint8 NewMeshId)
 {
-	// Determine if the character is currently able to sprint based on the Rotation mode and current acceleration
-	// (input) rotation. If the character is in the Looking Rotation mode, only allow sprinting if there is full
-	// movement input and it is faced forward relative to the camera + or - 50 degrees.
+	SetVisibleMeshId(NewMeshId);
+}
 
-	if (!bHasMovementInput || RotationMode == EALSRotationMode::Aiming)
+void AALSBaseCharacter::SetVisibleMeshId(uint8 NewMeshId)
+{
+	if (VisibleMeshId != NewMeshId)
 	{
-		return false;
+		VisibleMeshId = NewMeshId;
+
+		// Registered meshes are replicated by id only, clients stream them in. Clearing the reference also lets the
+		// previous unregistered mesh unload
+		VisibleMesh = nullptr;
+		LoadVisibleMeshById();
+
+		if (GetLocalRole() != ROLE_Authority)
+		{
+			Server_SetVisibleMeshId(NewMeshId);
+		}
 	}
+}
 
-	const bool bValidInputAmount = MovementInputAmount > 0.9f;
+void AALSBaseCharacter::LoadVisibleMeshById()
+{
+	CancelVisibleMeshLoad();
 
-	if (RotationMode == EALSRotationMode::VelocityDirection)
+	const TSoftObjectPtr<USkeletalMesh> NewMesh = MeshRegistry
+		                                               ? MeshRegistry->GetMesh(VisibleMeshId)
+		                                               : TSoftObjectPtr<USkeletalMesh>();
+	if (NewMesh.IsNull())
 	{
-		return bValidInputAmount;
+		return;
 	}
 
-	if (RotationMode == EALSRotationMode::LookingDirection)
+	if (USkeletalMesh* LoadedMesh = NewMesh.Get())
 	{
-		const FRotator AccRot = ReplicatedCurrentAcceleration.ToOrientationRotator();
-		FRotator Delta = AccRot - AimingRotation;
-		Delta.Normalize();
+		ApplyVisibleMesh(LoadedMesh);
+		return;
+	}
 
-		return bValidInputAmount && FMath::Abs(Delta.Yaw) < 50.0f;
+	// Keep showing the current mesh until the new one is streamed in
+	VisibleMeshHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		NewMesh.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &AALSBaseCharacter::OnVisibleMeshLoaded, VisibleMeshId));
+}
+
+void AALSBaseCharacter::OnVisibleMeshLoaded(uint8 LoadedMeshId)
+{
+	if (LoadedMeshId == VisibleMeshId && MeshRegistry)
+	{
+		VisibleMeshHandle.Reset();
+		if (USkeletalMesh* LoadedMesh = MeshRegistry->GetMesh(LoadedMeshId).Get())
+		{
+			ApplyVisibleMesh(LoadedMesh);
+		}
 	}
+}
 
-	return false;
+void AALSBaseCharacter::CancelVisibleMeshLoad()
+{
+	if (VisibleMeshHandle.IsValid())
+	{
+		if (VisibleMeshHandle->IsLoadingInProgress())
+		{
+			VisibleMeshHandle->CancelHandle();
+		}
+		VisibleMeshHandle.Reset();
+	}
 }
 
-FVector AALSBaseCharacter::GetMovementInput() const
+void AALSBaseCharacter::ApplyVisibleMesh(USkeletalMesh* NewVisibleMesh)
 {
-	return ReplicatedCurrentAcceleration;
+	const USkeletalMesh* PrevVisibleMesh = GetMesh()->GetSkeletalMeshAsset();
+	if (PrevVisibleMesh != NewVisibleMesh)
+	{
+		// Update the Skeletal Mesh before we update materials and anim bp variables
+		GetMesh()->SetSkeletalMesh(NewVisibleMesh);
+		OnVisibleMeshChanged(PrevVisibleMesh);
+	}
 }
 
-float AALSBaseCharacter::GetAnimCurveValue(FName CurveName) const
+void AALSBaseCharacter::PreloadActionAssets()
 {
-	if (GetMesh()->GetAnimInstance())
+	TArray<FSoftObjectPath> AssetsToLoad;
+	if (ActionAssets)
 	{
-		return GetMesh()->GetAnimInstance()->GetCurveValue(CurveName);
+		ActionAssets->GetActions(OverlayState).GetAssetsToLoad(AssetsToLoad);
 	}
 
-	return 0.0f;
+	// Release the previous overlay state after requesting the new one, so assets shared by both stay loaded
+	const TSharedPtr<FStreamableHandle> PrevActionAssetsHandle = ActionAssetsHandle;
+	ActionAssetsHandle.Reset();
+	if (AssetsToLoad.Num() > 0)
+	{
+		ActionAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate());
+	}
+	if (PrevActionAssetsHandle.IsValid())
+	{
+		PrevActionAssetsHandle->ReleaseHandle();
+	}
 }
 
-void AALSBaseCharacter::SetVisibleMesh(USkeletalMesh* NewVisibleMesh)
+template <typename T>
+static T* LoadActionAsset(const TSoftObjectPtr<T>& Asset)
 {
-	if (VisibleMesh != NewVisibleMesh)
+	if (T* LoadedAsset = Asset.Get())
 	{
-		const USkeletalMesh* Prev = VisibleMesh;
-		VisibleMesh = NewVisibleMesh;
-		OnVisibleMeshChanged(Prev);
+		return LoadedAsset;
+	}
+	if (Asset.IsNull())
+	{
+		return nullptr;
+	}
 
-		if (GetLocalRole() != ROLE_Authority)
-		{
-			Server_SetVisibleMesh(NewVisibleMesh);
-		}
+	// Only reached if the action starts before the overlay state's assets finished streaming in
+	INC_DWORD_STAT(STAT_ALS_ActionAssetSyncLoads);
+	return Asset.LoadSynchronous();
+}
+
+bool AALSBaseCharacter::FindMantleActionAsset(EALSMantleType MantleType, FALSMantleAsset& OutMantleAsset) const
+{
+	if (!ActionAssets)
+	{
+		return false;
 	}
+
+	const FALSSoftMantleAsset& Asset = ActionAssets->GetActions(OverlayState).GetMantleAsset(MantleType);
+	OutMantleAsset.AnimMontage = LoadActionAsset(Asset.AnimMontage);
+	OutMantleAsset.PositionCorrectionCurve = LoadActionAsset(Asset.PositionCorrectionCurve);
+	OutMantleAsset.StartingOffset = Asset.StartingOffset;
+	OutMantleAsset.LowHeight = Asset.LowHeight;
+	OutMantleAsset.LowPlayRate = Asset.LowPlayRate;
+	OutMantleAsset.LowStartPosition = Asset.LowStartPosition;
+	OutMantleAsset.HighHeight = Asset.HighHeight;
+	OutMantleAsset.HighPlayRate = Asset.HighPlayRate;
+	OutMantleAsset.HighStartPosition = Asset.HighStartPosition;
+	return true;
 }
 
-void AALSBaseCharacter::Server_SetVisibleMesh_Implementation(USkeletalMesh* NewVisibleMesh)
+UAnimMontage* AALSBaseCharacter::FindRollAnimation()
 {
-	SetVisibleMesh(NewVisibleMesh);
+	return ActionAssets ? LoadActionAsset(ActionAssets->GetActions(OverlayState).Roll) : GetRollAnimation();
+}
+
+UAnimMontage* AALSBaseCharacter::FindGetUpAnimation(bool bRagdollFaceUpState)
+{
+	if (!ActionAssets)
+	{
+		return GetGetUpAnimation(bRagdollFaceUpState);
+	}
+
+	const FALSOverlayActionAssets& Actions = ActionAssets->GetActions(OverlayState);
+	return LoadActionAsset(bRagdollFaceUpState ? Actions.GetUpFaceUp : Actions.GetUpFaceDown);
 }
 
 void AALSBaseCharacter::SetRightShoulder(bool bNewRightShoulder)
@@ -640,7 +1104,7 @@ FTransform AALSBaseCharacter::GetThirdPersonPivotTarget()
 
 FVector AALSBaseCharacter::GetFirstPersonCameraTarget()
 {
-	return GetMesh()->GetSocketLocation(NAME_FP_Camera);
+	return BoneIndexCache.GetSocketLocation(GetMesh(), NAME_FP_Camera);
 }
 
 void AALSBaseCharacter::GetCameraParameters(float& TPFOVOut, float& FPFOVOut, bool& bRightShoulderOut) const
@@ -654,6 +1118,16 @@ void AALSBaseCharacter::RagdollUpdate(float DeltaTime)
 {
 	GetMesh()->bOnlyAllowAutonomousTickPose = false;
 
+	if (bRagdollSettled)
+	{
+		// Settled ragdoll is sleeping, only wake it up if something (e.g. an impulse) woke its bodies.
+		if (!GetMesh()->RigidBodyIsAwake())
+		{
+			return;
+		}
+		RagdollWake();
+	}
+
 	// Set the Last Ragdoll Velocity.
 	const FVector NewRagdollVel = GetMesh()->GetPhysicsLinearVelocity(NAME_root);
 	LastRagdollVelocity = (NewRagdollVel != FVector::ZeroVector || IsLocallyControlled())
@@ -661,9 +1135,20 @@ void AALSBaseCharacter::RagdollUpdate(float DeltaTime)
 		                      : LastRagdollVelocity / 2;
 
 	// Use the Ragdoll Velocity to scale the ragdoll's joint strength for physical animation.
-	const float SpringValue = FMath::GetMappedRangeValueClamped<float, float>({0.0f, 1000.0f}, {0.0f, 25000.0f},
-	                                                            LastRagdollVelocity.Size());
-	GetMesh()->SetAllMotorsAngularDriveParams(SpringValue, 0.0f, 0.0f, false);
+	// Simple ragdolls have no constraints to drive.
+	// Setting drive params walks all constraints, so the spring is quantized and only applied when its step changes.
+	if (RagdollLOD != EALSRagdollLOD::Simple || !SimpleRagdollPhysicsAsset)
+	{
+		const float SpringAlpha = FMath::GetMappedRangeValueClamped<float, float>({0.0f, 1000.0f}, {0.0f, 1.0f},
+		                                                            LastRagdollVelocity.Size());
+		const int32 SpringStep = FMath::RoundToInt(SpringAlpha * RagdollDriveSpringSteps);
+		if (SpringStep != RagdollDriveSpringStep)
+		{
+			RagdollDriveSpringStep = SpringStep;
+			const float SpringValue = 25000.0f * SpringStep / RagdollDriveSpringSteps;
+			GetMesh()->SetAllMotorsAngularDriveParams(SpringValue, 0.0f, 0.0f, false);
+		}
+	}
 
 	// Disable Gravity if falling faster than -4000 to prevent continual acceleration.
 	// This also prevents the ragdoll from going through the floor.
@@ -672,6 +1157,40 @@ void AALSBaseCharacter::RagdollUpdate(float DeltaTime)
 
 	// Update the Actor location to follow the ragdoll.
 	SetActorLocationDuringRagdoll(DeltaTime);
+
+	// Settle the ragdoll if it stayed at rest on the ground long enough.
+	if (bEnableRagdollSettling && bRagdollOnGround &&
+		LastRagdollVelocity.SizeSquared() < FMath::Square(RagdollSettleVelocity))
+	{
+		RagdollSettleFrames++;
+		if (RagdollSettleFrames >= RagdollSettleFrameCount)
+		{
+			RagdollSettle();
+		}
+	}
+	else
+	{
+		RagdollSettleFrames = 0;
+	}
+}
+
+void AALSBaseCharacter::RagdollSettle()
+{
+	// Stop driving the motors and put all bodies to sleep. Ragdoll update, capsule follow trace and
+	// location replication are skipped until the bodies are woken up again.
+	bRagdollSettled = true;
+	RagdollSettleFrames = 0;
+	LastRagdollVelocity = FVector::ZeroVector;
+	RagdollDriveSpringStep = 0;
+	GetMesh()->SetAllMotorsAngularDriveParams(0.0f, 0.0f, 0.0f, false);
+	GetMesh()->PutAllRigidBodiesToSleep();
+}
+
+void AALSBaseCharacter::RagdollWake()
+{
+	bRagdollSettled = false;
+	RagdollSettleFrames = 0;
+	ServerRagdollPull = 0;
 }
 
 void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
@@ -679,7 +1198,7 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	if (IsLocallyControlled())
 	{
 		// Set the pelvis as the target location.
-		TargetRagdollLocation = GetMesh()->GetSocketLocation(NAME_Pelvis);
+		TargetRagdollLocation = BoneIndexCache.GetSocketLocation(GetMesh(), NAME_Pelvis);
 		if (!HasAuthority())
 		{
 			Server_SetMeshLocationDuringRagdoll(TargetRagdollLocation);
@@ -687,7 +1206,7 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	}
 
 	// Determine whether the ragdoll is facing up or down and set the target rotation accordingly.
-	const FRotator PelvisRot = GetMesh()->GetSocketRotation(NAME_Pelvis);
+	const FRotator PelvisRot = BoneIndexCache.GetSocketRotation(GetMesh(), NAME_Pelvis);
 
 	if (bReversedPelvis) {
 		bRagdollFaceUp = PelvisRot.Roll > 0.0f;
@@ -707,12 +1226,12 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 	UWorld* World = GetWorld();
 	check(World);
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
+	const FCollisionQueryParams Params = UALSSceneQuerySubsystem::MakeGroundProbeParams(this);
 
 	FHitResult HitResult;
-	const bool bHit = World->LineTraceSingleByChannel(HitResult, TargetRagdollLocation, TraceVect,
-	                                                  ECC_Visibility, Params);
+	const bool bHit = UALSSceneQuerySubsystem::ProbeGround(World, EALSSceneQueryType::Ragdoll, this, 0, HitResult,
+	                                                       TargetRagdollLocation, TraceVect,
+	                                                       UALSSceneQuerySubsystem::GroundProbeChannel, Params);
 
 	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
 	{
@@ -741,7 +1260,7 @@ void AALSBaseCharacter::SetActorLocationDuringRagdoll(float DeltaTime)
 		float RagdollSpeed = FVector(LastRagdollVelocity.X, LastRagdollVelocity.Y, 0).Size();
 		FName RagdollSocketPullName = RagdollSpeed > 300 ? NAME_spine_03 : NAME_pelvis;
 		GetMesh()->AddForce(
-			(TargetRagdollLocation - GetMesh()->GetSocketLocation(RagdollSocketPullName)) * ServerRagdollPull,
+			(TargetRagdollLocation - BoneIndexCache.GetSocketLocation(GetMesh(), RagdollSocketPullName)) * ServerRagdollPull,
 			RagdollSocketPullName, true);
 	}
 	SetActorLocationAndTargetRotation(bRagdollOnGround ? NewRagdollLoc : TargetRagdollLocation, TargetRagdollRotation);
@@ -824,6 +1343,7 @@ void AALSBaseCharacter::OnStanceChanged(const EALSStance PreviousStance)
 		CameraBehavior->Stance = Stance;
 	}
 
+	MovementSettingsIndex = FALSMovementModel::GetSettingsIndex(RotationMode, Stance);
 	MyCharacterMovementComponent->SetMovementSettings(GetTargetMovementSettings());
 }
 
@@ -841,6 +1361,7 @@ void AALSBaseCharacter::OnRotationModeChanged(EALSRotationMode PreviousRotationM
 		CameraBehavior->SetRotationMode(RotationMode);
 	}
 
+	MovementSettingsIndex = FALSMovementModel::GetSettingsIndex(RotationMode, Stance);
 	MyCharacterMovementComponent->SetMovementSettings(GetTargetMovementSettings());
 }
 
@@ -876,12 +1397,12 @@ void AALSBaseCharacter::OnViewModeChanged(const EALSViewMode PreviousViewMode)
 
 void AALSBaseCharacter::OnOverlayStateChanged(const EALSOverlayState PreviousState)
 {
+	PreloadActionAssets();
 }
 
 void AALSBaseCharacter::OnVisibleMeshChanged(const USkeletalMesh* PrevVisibleMesh)
 {
-	// Update the Skeletal Mesh before we update materials and anim bp variables
-	GetMesh()->SetSkeletalMesh(VisibleMesh);
+	BoneIndexCache.Reset();
 
 	// Reset materials to their new mesh defaults
 	if (GetMesh() != nullptr)
@@ -896,6 +1417,11 @@ void AALSBaseCharacter::OnVisibleMeshChanged(const USkeletalMesh* PrevVisibleMes
 	ForceUpdateCharacterState();
 }
 
+void AALSBaseCharacter::OnSignificanceTierChanged(EALSSignificanceTier PreviousTier)
+{
+	ApplySignificanceTier();
+}
+
 void AALSBaseCharacter::OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust)
 {
 	Super::OnStartCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
@@ -987,8 +1513,13 @@ void AALSBaseCharacter::SetEssentialValues(float DeltaTime)
 	// The Movement Input Amount is equal to the current acceleration divided by the max acceleration so that
 	// it has a range of 0-1, 1 being the maximum possible amount of input, and 0 being none.
 	// If the character has movement input, update the Last Movement Input Rotation.
+	const bool bHadMovementInput = bHasMovementInput;
 	MovementInputAmount = ReplicatedCurrentAcceleration.Size() / EasedMaxAcceleration;
 	bHasMovementInput = MovementInputAmount > 0.0f;
+	if (bHasMovementInput && !bHadMovementInput)
+	{
+		StateEvent.Broadcast(this);
+	}
 	if (bHasMovementInput)
 	{
 		LastMovementInputRotation = ReplicatedCurrentAcceleration.ToOrientationRotator();
@@ -1023,6 +1554,9 @@ void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 		const bool bCanUpdateMovingRot = ((bIsMoving && bHasMovementInput) || Speed > 150.0f) && !HasAnyRootMotion();
 		if (bCanUpdateMovingRot)
 		{
+			// Moving interrupts the baked turn in place, same as the turn animation blending out
+			BakedTurnTime = -1.0f;
+
 			const float GroundedRotationRate = CalculateGroundedRotationRate();
 			if (RotationMode == EALSRotationMode::VelocityDirection)
 			{
@@ -1041,7 +1575,7 @@ void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 				else
 				{
 					// Walking or Running..
-					const float YawOffsetCurveVal = GetAnimCurveValue(NAME_YawOffset);
+					const float YawOffsetCurveVal = GetYawOffsetValue();
 					YawValue = AimingRotation.Yaw + YawOffsetCurveVal;
 				}
 				SmoothCharacterRotation({0.0f, YawValue, 0.0f}, 500.0f, GroundedRotationRate, DeltaTime);
@@ -1066,7 +1600,7 @@ void AALSBaseCharacter::UpdateGroundedRotation(float DeltaTime)
 			// The Rotation Amount curve defines how much rotation should be applied each frame,
 			// and is calculated for animations that are animated at 30fps.
 
-			const float RotAmountCurve = GetAnimCurveValue(NAME_RotationAmount);
+			const float RotAmountCurve = GetRotationAmountValue(DeltaTime);
 
 			if (FMath::Abs(RotAmountCurve) > 0.001f)
 			{
@@ -1116,27 +1650,10 @@ EALSGait AALSBaseCharacter::GetAllowedGait() const
 	// Calculate the Allowed Gait. This represents the maximum Gait the character is currently allowed to be in,
 	// and can be determined by the desired gait, the rotation mode, the stance, etc. For example,
 	// if you wanted to force the character into a walking state while indoors, this could be done here.
-
-	if (Stance == EALSStance::Standing)
-	{
-		if (RotationMode != EALSRotationMode::Aiming)
-		{
-			if (DesiredGait == EALSGait::Sprinting)
-			{
-				return CanSprint() ? EALSGait::Sprinting : EALSGait::Running;
-			}
-			return DesiredGait;
-		}
-	}
-
-	// Crouching stance & Aiming rot mode has same behaviour
-
-	if (DesiredGait == EALSGait::Sprinting)
-	{
-		return EALSGait::Running;
-	}
-
-	return DesiredGait;
+	const bool bCanSprint = DesiredGait == EALSGait::Sprinting && CanSprint();
+	return static_cast<EALSGait>(ALSLocomotionCore::GetAllowedGait(
+		static_cast<ALSLocomotionCore::EStance>(Stance), static_cast<ALSLocomotionCore::ERotationMode>(RotationMode),
+		static_cast<ALSLocomotionCore::EGait>(DesiredGait), bCanSprint));
 }
 
 EALSGait AALSBaseCharacter::GetActualGait(EALSGait AllowedGait) const
@@ -1144,25 +1661,9 @@ EALSGait AALSBaseCharacter::GetActualGait(EALSGait AllowedGait) const
 	// Get the Actual Gait. This is calculated by the actual movement of the character,  and so it can be different
 	// from the desired gait or allowed gait. For instance, if the Allowed Gait becomes walking,
 	// the Actual gait will still be running until the character decelerates to the walking speed.
-
-	const float LocWalkSpeed = MyCharacterMovementComponent->CurrentMovementSettings.WalkSpeed;
-	const float LocRunSpeed = MyCharacterMovementComponent->CurrentMovementSettings.RunSpeed;
-
-	if (Speed > LocRunSpeed + 10.0f)
-	{
-		if (AllowedGait == EALSGait::Sprinting)
-		{
-			return EALSGait::Sprinting;
-		}
-		return EALSGait::Running;
-	}
-
-	if (Speed >= LocWalkSpeed + 10.0f)
-	{
-		return EALSGait::Running;
-	}
-
-	return EALSGait::Walking;
+	const FALSMovementSettings& Settings = MyCharacterMovementComponent->CurrentMovementSettings;
+	return static_cast<EALSGait>(ALSLocomotionCore::GetActualGait(static_cast<ALSLocomotionCore::EGait>(AllowedGait),
+	                                                              Speed, Settings.WalkSpeed, Settings.RunSpeed));
 }
 
 void AALSBaseCharacter::SmoothCharacterRotation(FRotator Target, float TargetInterpSpeed, float ActorInterpSpeed,
@@ -1184,8 +1685,60 @@ float AALSBaseCharacter::CalculateGroundedRotationRate() const
 	const float MappedSpeedVal = MyCharacterMovementComponent->GetMappedSpeed();
 	const float CurveVal =
 		MyCharacterMovementComponent->CurrentMovementSettings.RotationRateCurve->GetFloatValue(MappedSpeedVal);
-	const float ClampedAimYawRate = FMath::GetMappedRangeValueClamped<float, float>({0.0f, 300.0f}, {1.0f, 3.0f}, AimYawRate);
-	return CurveVal * ClampedAimYawRate;
+	return ALSLocomotionCore::CalculateGroundedRotationRate(CurveVal, AimYawRate);
+}
+
+float AALSBaseCharacter::GetYawOffsetValue() const
+{
+	if (!bUsingBakedCurves)
+	{
+		return GetAnimCurveValue(NAME_YawOffset);
+	}
+
+	const float VelocityDirection = UKismetMathLibrary::NormalizedDeltaRotator(LastVelocityRotation, AimingRotation).Yaw;
+	return BakedYawOffsetCurve->GetFloatValue(VelocityDirection);
+}
+
+float AALSBaseCharacter::GetRotationAmountValue(float DeltaTime)
+{
+	if (!bUsingBakedCurves)
+	{
+		return GetAnimCurveValue(NAME_RotationAmount);
+	}
+
+	// Mirror the anim instance turn in place check, and play back the baked curve instead of the turn animation.
+	if (BakedTurnTime < 0.0f)
+	{
+		const float AimingAngle = UKismetMathLibrary::NormalizedDeltaRotator(AimingRotation, GetActorRotation()).Yaw;
+		if (RotationMode != EALSRotationMode::LookingDirection || ViewMode != EALSViewMode::ThirdPerson ||
+			FMath::Abs(AimingAngle) <= BakedTurnCheckMinAngle)
+		{
+			BakedTurnDelayTime = 0.0f;
+			return 0.0f;
+		}
+
+		BakedTurnDelayTime += DeltaTime;
+		if (BakedTurnDelayTime < BakedTurnDelay)
+		{
+			return 0.0f;
+		}
+
+		BakedTurnDelayTime = 0.0f;
+		BakedTurnTime = 0.0f;
+		BakedTurnScale = AimingAngle / 90.0f;
+	}
+
+	float MinTime;
+	float MaxTime;
+	BakedTurnInPlaceCurve->GetTimeRange(MinTime, MaxTime);
+	BakedTurnTime += DeltaTime;
+	if (BakedTurnTime > MaxTime)
+	{
+		BakedTurnTime = -1.0f;
+		return 0.0f;
+	}
+
+	return BakedTurnInPlaceCurve->GetFloatValue(BakedTurnTime) * BakedTurnScale;
 }
 
 void AALSBaseCharacter::LimitRotation(float AimYawMin, float AimYawMax, float InterpSpeed, float DeltaTime)
@@ -1343,7 +1896,7 @@ void AALSBaseCharacter::StanceAction_Implementation()
 	if (LastStanceInputTime - PrevStanceInputTime <= RollDoubleTapTimeout)
 	{
 		// Roll
-		Replicated_PlayMontage(GetRollAnimation(), 1.15f);
+		Replicated_PlayMontage(FindRollAnimation(), 1.15f);
 
 		if (Stance == EALSStance::Standing)
 		{
@@ -1454,5 +2007,22 @@ void AALSBaseCharacter::OnRep_OverlayState(EALSOverlayState PrevOverlayState)
 
 void AALSBaseCharacter::OnRep_VisibleMesh(const USkeletalMesh* PreviousSkeletalMesh)
 {
-	OnVisibleMeshChanged(PreviousSkeletalMesh);
+	if (VisibleMeshId == 0)
+	{
+		ApplyVisibleMesh(VisibleMesh);
+	}
+}
+
+void AALSBaseCharacter::OnRep_VisibleMeshId()
+{
+	if (VisibleMeshId == 0)
+	{
+		// Back to the mesh replicated by reference, it may be null and not have changed while the registered mesh was
+		// shown
+		CancelVisibleMeshLoad();
+		ApplyVisibleMesh(VisibleMesh);
+		return;
+	}
+
+	LoadVisibleMeshById();
 }
@@ -5,9 +5,22 @@
 #include "Character/ALSCharacter.h"
 
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/AssetManager.h"
 #include "Engine/StaticMesh.h"
 #include "AI/ALSAIController.h"
+#include "Character/ALSOverlayAssets.h"
 #include "Kismet/GameplayStatics.h"
+#include "Library/ALSStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Held Object Streams"), STAT_ALS_HeldObjectStreams, STATGROUP_ALS);
+
+static const FName NAME__ALSCharacter__FP_Camera(TEXT("FP_Camera"));
+static const FName NAME__ALSCharacter__Head(TEXT("Head"));
+static const FName NAME__ALSCharacter__TP_CameraTrace_L(TEXT("TP_CameraTrace_L"));
+static const FName NAME__ALSCharacter__TP_CameraTrace_R(TEXT("TP_CameraTrace_R"));
+static const FName NAME__ALSCharacter__root(TEXT("root"));
+static const FName NAME__ALSCharacter__VB_LHS_ik_hand_gun(TEXT("VB LHS_ik_hand_gun"));
+static const FName NAME__ALSCharacter__VB_RHS_ik_hand_gun(TEXT("VB RHS_ik_hand_gun"));
 
 AALSCharacter::AALSCharacter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -49,15 +62,9 @@ void AALSCharacter::AttachToHand(UStaticMesh* NewStaticMesh, USkeletalMesh* NewS
 		}
 	}
 
-	FName AttachBone;
-	if (bLeftHand)
-	{
-		AttachBone = TEXT("VB LHS_ik_hand_gun");
-	}
-	else
-	{
-		AttachBone = TEXT("VB RHS_ik_hand_gun");
-	}
+	const FName AttachBone = bLeftHand
+		                         ? NAME__ALSCharacter__VB_LHS_ik_hand_gun
+		                         : NAME__ALSCharacter__VB_RHS_ik_hand_gun;
 
 	HeldObjectRoot->AttachToComponent(GetMesh(),
 	                                  FAttachmentTransformRules::SnapToTargetNotIncludingScale, AttachBone);
@@ -73,45 +80,203 @@ void AALSCharacter::RagdollStart()
 void AALSCharacter::RagdollEnd()
 {
 	Super::RagdollEnd();
-	UpdateHeldObject();
+	RefreshHeldObject();
+}
+
+void AALSCharacter::ResetALSState()
+{
+	ClearHeldObject();
+	Super::ResetALSState();
+	RefreshHeldObject();
+}
+
+void AALSCharacter::RefreshHeldObject()
+{
+	// A pending load of the previous overlay state isn't needed anymore
+	if (HeldObjectHandle.IsValid())
+	{
+		HeldObjectHandle->CancelHandle();
+		HeldObjectHandle.Reset();
+	}
+
+	const FALSHeldObjectSettings* Settings = nullptr;
+	if (!UsesBlueprintHeldObject())
+	{
+		Settings = OverlayAssets->HeldObjects.Find(OverlayState);
+		PreloadHeldObjects(Settings ? Settings->PreloadOverlayStates : TArray<EALSOverlayState>());
+	}
+
+	if (UsesBlueprintHeldObject())
+	{
+		UpdateHeldObject();
+	}
+	else if (Settings)
+	{
+		TArray<FSoftObjectPath> AssetsToLoad;
+		Settings->GetAssetsToLoad(AssetsToLoad);
+		const bool bLoaded = !AssetsToLoad.ContainsByPredicate([](const FSoftObjectPath& Path)
+		{
+			return Path.ResolveObject() == nullptr;
+		});
+
+		if (bLoaded)
+		{
+			OnHeldObjectLoaded(OverlayState);
+			return;
+		}
+
+		// Hold nothing until the new object is streamed in, never load it synchronously
+		ClearHeldObject();
+		INC_DWORD_STAT(STAT_ALS_HeldObjectStreams);
+		HeldObjectHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+			AssetsToLoad, FStreamableDelegate::CreateUObject(this, &AALSCharacter::OnHeldObjectLoaded, OverlayState),
+			FStreamableManager::AsyncLoadHighPriority);
+	}
+	else
+	{
+		ClearHeldObject();
+	}
+
+	UpdateHeldObjectAnimationState(true);
+}
+
+void AALSCharacter::OnHeldObjectLoaded(EALSOverlayState LoadedOverlayState)
+{
+	const FALSHeldObjectSettings* Settings = OverlayAssets ? OverlayAssets->HeldObjects.Find(OverlayState) : nullptr;
+	if (LoadedOverlayState != OverlayState || !Settings || UsesBlueprintHeldObject())
+	{
+		return;
+	}
+
+	AttachToHand(Settings->StaticMesh.Get(), Settings->SkeletalMesh.Get(), Settings->AnimClass.Get(),
+	             Settings->bLeftHand, Settings->Offset);
+	UpdateHeldObjectAnimationState(true);
+}
+
+void AALSCharacter::PreloadHeldObjects(const TArray<EALSOverlayState>& OverlayStates)
+{
+	TArray<FSoftObjectPath> AssetsToLoad;
+	for (const EALSOverlayState PreloadState : OverlayStates)
+	{
+		if (const FALSHeldObjectSettings* Settings = OverlayAssets->HeldObjects.Find(PreloadState))
+		{
+			Settings->GetAssetsToLoad(AssetsToLoad);
+		}
+	}
+
+	// Release the previous preloads after requesting the new ones, so assets in both sets stay loaded
+	const TSharedPtr<FStreamableHandle> PrevPreloadHandle = PreloadHandle;
+	PreloadHandle.Reset();
+	if (AssetsToLoad.Num() > 0)
+	{
+		PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad, FStreamableDelegate());
+	}
+	if (PrevPreloadHandle.IsValid())
+	{
+		PrevPreloadHandle->ReleaseHandle();
+	}
+}
+
+void AALSCharacter::UpdateHeldObjectAnimationState(bool bForce)
+{
+	const bool bAiming = RotationMode == EALSRotationMode::Aiming;
+	if (bForce || HeldObjectOverlayState != OverlayState || HeldObjectStance != Stance ||
+		bHeldObjectAiming != bAiming)
+	{
+		HeldObjectOverlayState = OverlayState;
+		HeldObjectStance = Stance;
+		bHeldObjectAiming = bAiming;
+		UpdateHeldObjectAnimations();
+	}
 }
 
 ECollisionChannel AALSCharacter::GetThirdPersonTraceParams(FVector& TraceOrigin, float& TraceRadius)
 {
-	const FName CameraSocketName = bRightShoulder ? TEXT("TP_CameraTrace_R") : TEXT("TP_CameraTrace_L");
-	TraceOrigin = GetMesh()->GetSocketLocation(CameraSocketName);
+	const FName CameraSocketName = bRightShoulder
+		                               ? NAME__ALSCharacter__TP_CameraTrace_R
+		                               : NAME__ALSCharacter__TP_CameraTrace_L;
+	TraceOrigin = BoneIndexCache.GetSocketLocation(GetMesh(), CameraSocketName);
 	TraceRadius = 15.0f;
 	return ECC_Camera;
 }
 
 FTransform AALSCharacter::GetThirdPersonPivotTarget()
 {
-	return FTransform(GetActorRotation(),
-	                  (GetMesh()->GetSocketLocation(TEXT("Head")) + GetMesh()->GetSocketLocation(TEXT("root"))) / 2.0f,
-	                  FVector::OneVector);
+	const FVector HeadLocation = BoneIndexCache.GetSocketLocation(GetMesh(), NAME__ALSCharacter__Head);
+	const FVector RootLocation = BoneIndexCache.GetSocketLocation(GetMesh(), NAME__ALSCharacter__root);
+	return FTransform(GetActorRotation(), (HeadLocation + RootLocation) / 2.0f, FVector::OneVector);
 }
 
 FVector AALSCharacter::GetFirstPersonCameraTarget()
 {
-	return GetMesh()->GetSocketLocation(TEXT("FP_Camera"));
+	return BoneIndexCache.GetSocketLocation(GetMesh(), NAME__ALSCharacter__FP_Camera);
 }
 
 void AALSCharacter::OnOverlayStateChanged(EALSOverlayState PreviousState)
 {
 	Super::OnOverlayStateChanged(PreviousState);
-	UpdateHeldObject();
+	RefreshHeldObject();
+}
+
+void AALSCharacter::OnStanceChanged(EALSStance PreviousStance)
+{
+	Super::OnStanceChanged(PreviousStance);
+	UpdateHeldObjectAnimationState();
+}
+
+void AALSCharacter::OnRotationModeChanged(EALSRotationMode PreviousRotationMode)
+{
+	Super::OnRotationModeChanged(PreviousRotationMode);
+	UpdateHeldObjectAnimationState();
 }
 
 void AALSCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	UpdateHeldObjectAnimations();
+	if (bTickHeldObjectAnimations && bHasHeldObjectAnimations)
+	{
+		UpdateHeldObjectAnimations();
+	}
 }
 
 void AALSCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 
-	UpdateHeldObject();
+	bHasHeldObjectAnimations = GetClass()->IsFunctionImplementedInScript(
+		GET_FUNCTION_NAME_CHECKED(AALSCharacter, UpdateHeldObjectAnimations));
+
+	if (OverlayAssets && !bUseBlueprintHeldObject)
+	{
+		TArray<FSoftObjectPath> AssetsToLoad;
+		for (const EALSOverlayState PreloadState : OverlayAssets->InitialPreloadOverlayStates)
+		{
+			if (const FALSHeldObjectSettings* Settings = OverlayAssets->HeldObjects.Find(PreloadState))
+			{
+				Settings->GetAssetsToLoad(AssetsToLoad);
+			}
+		}
+		if (AssetsToLoad.Num() > 0)
+		{
+			InitialPreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+				AssetsToLoad, FStreamableDelegate());
+		}
+	}
+
+	RefreshHeldObject();
+}
+
+void AALSCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (TSharedPtr<FStreamableHandle>* Handle : {&HeldObjectHandle, &PreloadHandle, &InitialPreloadHandle})
+	{
+		if (Handle->IsValid())
+		{
+			(*Handle)->ReleaseHandle();
+			Handle->Reset();
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
@@ -4,19 +4,35 @@
 
 #include "Character/ALSCharacterMovementComponent.h"
 #include "Character/ALSBaseCharacter.h"
+#include "Library/ALSLocomotionCore.h"
+#include "Library/ALSStats.h"
 
 #include "Curves/CurveVector.h"
 
+DECLARE_CYCLE_STAT(TEXT("Movement Updated"), STAT_ALS_MovementUpdated, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Movement Phys Walking"), STAT_ALS_PhysWalking, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Movement Curves"), STAT_ALS_MovementCurves, STATGROUP_ALS);
+
 UALSCharacterMovementComponent::UALSCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 }
 
+void UALSCharacterMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+                                                   FActorComponentTickFunction* ThisTickFunction)
+{
+	ALS_SCOPED_STAGE_TIMING(MovementComponent);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
 void UALSCharacterMovementComponent::OnMovementUpdated(float DeltaTime, const FVector& OldLocation,
                                                        const FVector& OldVelocity)
 {
 	Super::OnMovementUpdated(DeltaTime, OldLocation, OldVelocity);
 
+	SCOPE_CYCLE_COUNTER(STAT_ALS_MovementUpdated);
+
 	if (!CharacterOwner)
 	{
 		return;
@@ -35,6 +51,9 @@ void UALSCharacterMovementComponent::OnMovementUpdated(float DeltaTime, const FV
 
 void UALSCharacterMovementComponent::PhysWalking(float deltaTime, int32 Iterations)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_PhysWalking);
+	CSV_SCOPED_TIMING_STAT(ALS, PhysWalking);
+
 	if (CurrentMovementSettings.MovementCurve)
 	{
 		// Update the Ground Friction using the Movement Curve.
@@ -46,6 +65,8 @@ void UALSCharacterMovementComponent::PhysWalking(float deltaTime, int32 Iteratio
 
 float UALSCharacterMovementComponent::GetMaxAcceleration() const
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_MovementCurves);
+
 	// Update the Acceleration using the Movement Curve.
 	// This allows for fine control over movement behavior at each speed.
 	if (!IsMovingOnGround() || !CurrentMovementSettings.MovementCurve)
@@ -57,6 +78,8 @@ float UALSCharacterMovementComponent::GetMaxAcceleration() const
 
 float UALSCharacterMovementComponent::GetMaxBrakingDeceleration() const
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_MovementCurves);
+
 	// Update the Deceleration using the Movement Curve.
 	// This allows for fine control over movement behavior at each speed.
 	if (!IsMovingOnGround() || !CurrentMovementSettings.MovementCurve)
@@ -156,26 +179,11 @@ float UALSCharacterMovementComponent::GetMappedSpeed() const
 	// Map the character's current speed to the configured movement speeds with a range of 0-3,
 	// with 0 = stopped, 1 = the Walk Speed, 2 = the Run Speed, and 3 = the Sprint Speed.
 	// This allows us to vary the movement speeds but still use the mapped range in calculations for consistent results
-
-	const float Speed = Velocity.Size2D();
-	const float LocWalkSpeed = CurrentMovementSettings.WalkSpeed;
-	const float LocRunSpeed = CurrentMovementSettings.RunSpeed;
-	const float LocSprintSpeed = CurrentMovementSettings.SprintSpeed;
-
-	if (Speed > LocRunSpeed)
-	{
-		return FMath::GetMappedRangeValueClamped<float, float>({LocRunSpeed, LocSprintSpeed}, {2.0f, 3.0f}, Speed);
-	}
-
-	if (Speed > LocWalkSpeed)
-	{
-		return FMath::GetMappedRangeValueClamped<float, float>({LocWalkSpeed, LocRunSpeed}, {1.0f, 2.0f}, Speed);
-	}
-
-	return FMath::GetMappedRangeValueClamped<float, float>({0.0f, LocWalkSpeed}, {0.0f, 1.0f}, Speed);
+	return ALSLocomotionCore::GetMappedSpeed(Velocity.Size2D(), CurrentMovementSettings.WalkSpeed,
+	                                         CurrentMovementSettings.RunSpeed, CurrentMovementSettings.SprintSpeed);
 }
 
-void UALSCharacterMovementComponent::SetMovementSettings(FALSMovementSettings NewMovementSettings)
+void UALSCharacterMovementComponent::SetMovementSettings(const FALSMovementSettings& NewMovementSettings)
 {
 	// Set the current movement settings from the owner
 	CurrentMovementSettings = NewMovementSettings;
@@ -0,0 +1,41 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Character/ALSMeshRegistry.h"
+
+#include "Engine/SkeletalMesh.h"
+#include "Misc/DataValidation.h"
+
+#define LOCTEXT_NAMESPACE "ALSMeshRegistry"
+
+uint8 UALSMeshRegistry::FindMeshId(const TSoftObjectPtr<USkeletalMesh>& Mesh) const
+{
+	if (Mesh.IsNull())
+	{
+		return 0;
+	}
+
+	const int32 Index = Meshes.IndexOfByKey(Mesh);
+	return Index != INDEX_NONE && Index < MaxMeshes ? static_cast<uint8>(Index + 1) : 0;
+}
+
+TSoftObjectPtr<USkeletalMesh> UALSMeshRegistry::GetMesh(uint8 MeshId) const
+{
+	return Meshes.IsValidIndex(MeshId - 1) ? Meshes[MeshId - 1] : TSoftObjectPtr<USkeletalMesh>();
+}
+
+#if WITH_EDITOR
+EDataValidationResult UALSMeshRegistry::IsDataValid(FDataValidationContext& Context) const
+{
+	if (Meshes.Num() > MaxMeshes)
+	{
+		Context.AddError(FText::Format(LOCTEXT("TooManyMeshes", "Mesh registry supports up to {0} meshes"),
+		                               MaxMeshes));
+		return EDataValidationResult::Invalid;
+	}
+	return Super::IsDataValid(Context);
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
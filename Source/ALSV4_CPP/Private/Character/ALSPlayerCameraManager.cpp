@@ -9,8 +9,12 @@
 #include "Character/ALSPlayerController.h"
 #include "Character/Animation/ALSPlayerCameraBehavior.h"
 #include "Components/ALSDebugComponent.h"
+#include "Subsystems/ALSSceneQuerySubsystem.h"
 
 #include "Kismet/KismetMathLibrary.h"
+#include "Library/ALSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Camera Behavior"), STAT_ALS_CameraBehavior, STATGROUP_ALS);
 
 
 const FName NAME_CameraBehavior(TEXT("CameraBehavior"));
@@ -122,6 +126,9 @@ FVector AALSPlayerCameraManager::CalculateAxisIndependentLag(FVector CurrentLoca
 
 bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Location, FRotator& Rotation, float& FOV)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CameraBehavior);
+	CSV_SCOPED_TIMING_STAT(ALS, CameraBehavior);
+
 	if (!ControlledCharacter)
 	{
 		return false;
@@ -195,8 +202,9 @@ bool AALSPlayerCameraManager::CustomCameraBehavior(float DeltaTime, FVector& Loc
 
 	FHitResult HitResult;
 	const FCollisionShape SphereCollisionShape = FCollisionShape::MakeSphere(TraceRadius);
-	const bool bHit = World->SweepSingleByChannel(HitResult, TraceOrigin, TargetCameraLocation, FQuat::Identity,
-	                                              TraceChannel, SphereCollisionShape, Params);
+	const bool bHit = UALSSceneQuerySubsystem::SweepSingleByChannel(World, EALSSceneQueryType::Camera, ControlledCharacter,
+	                                                                0, HitResult, TraceOrigin, TargetCameraLocation,
+	                                                                TraceChannel, SphereCollisionShape, Params);
 
 	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
 	{
@@ -12,12 +12,14 @@
 #include "Character/ALSCharacter.h"
 #include "Character/ALSPlayerCameraManager.h"
 #include "Components/ALSDebugComponent.h"
+#include "Components/ALSInputReplayComponent.h"
 #include "Kismet/GameplayStatics.h"
 
 void AALSPlayerController::OnPossess(APawn* NewPawn)
 {
 	Super::OnPossess(NewPawn);
 	PossessedCharacter = Cast<AALSBaseCharacter>(NewPawn);
+	InputReplayComponent = PossessedCharacter ? PossessedCharacter->FindComponentByClass<UALSInputReplayComponent>() : nullptr;
 	if (!IsRunningDedicatedServer())
 	{
 		// Servers want to setup camera only in listen servers.
@@ -39,6 +41,7 @@ void AALSPlayerController::OnRep_Pawn()
 {
 	Super::OnRep_Pawn();
 	PossessedCharacter = Cast<AALSBaseCharacter>(GetPawn());
+	InputReplayComponent = PossessedCharacter ? PossessedCharacter->FindComponentByClass<UALSInputReplayComponent>() : nullptr;
 	SetupCamera();
 	SetupInputs();
 	
@@ -112,6 +115,19 @@ void AALSPlayerController::SetupInputs()
 	}
 }
 
+bool AALSPlayerController::CanForwardInput() const
+{
+	return !InputReplayComponent || !InputReplayComponent->IsReplaying();
+}
+
+void AALSPlayerController::RecordInput(EALSReplayInputAction Action, float Value) const
+{
+	if (InputReplayComponent)
+	{
+		InputReplayComponent->RecordInput(Action, Value);
+	}
+}
+
 void AALSPlayerController::SetupCamera()
 {
 	// Call "OnPossess" in Player Camera Manager when possessing a pawn
@@ -124,112 +140,126 @@ void AALSPlayerController::SetupCamera()
 
 void AALSPlayerController::ForwardMovementAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::ForwardMovement, Value.GetMagnitude());
 		PossessedCharacter->ForwardMovementAction(Value.GetMagnitude());
 	}
 }
 
 void AALSPlayerController::RightMovementAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::RightMovement, Value.GetMagnitude());
 		PossessedCharacter->RightMovementAction(Value.GetMagnitude());
 	}
 }
 
 void AALSPlayerController::CameraUpAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::CameraUp, Value.GetMagnitude());
 		PossessedCharacter->CameraUpAction(Value.GetMagnitude());
 	}
 }
 
 void AALSPlayerController::CameraRightAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::CameraRight, Value.GetMagnitude());
 		PossessedCharacter->CameraRightAction(Value.GetMagnitude());
 	}
 }
 
 void AALSPlayerController::JumpAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::Jump, Value.Get<bool>());
 		PossessedCharacter->JumpAction(Value.Get<bool>());
 	}
 }
 
 void AALSPlayerController::SprintAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::Sprint, Value.Get<bool>());
 		PossessedCharacter->SprintAction(Value.Get<bool>());
 	}
 }
 
 void AALSPlayerController::AimAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::Aim, Value.Get<bool>());
 		PossessedCharacter->AimAction(Value.Get<bool>());
 	}
 }
 
 void AALSPlayerController::CameraTapAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::CameraTap, 1.0f);
 		PossessedCharacter->CameraTapAction();
 	}
 }
 
 void AALSPlayerController::CameraHeldAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter)
+	if (PossessedCharacter && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::CameraHeld, 1.0f);
 		PossessedCharacter->CameraHeldAction();
 	}
 }
 
 void AALSPlayerController::StanceAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter && Value.Get<bool>())
+	if (PossessedCharacter && Value.Get<bool>() && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::Stance, 1.0f);
 		PossessedCharacter->StanceAction();
 	}
 }
 
 void AALSPlayerController::WalkAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter && Value.Get<bool>())
+	if (PossessedCharacter && Value.Get<bool>() && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::Walk, 1.0f);
 		PossessedCharacter->WalkAction();
 	}
 }
 
 void AALSPlayerController::RagdollAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter && Value.Get<bool>())
+	if (PossessedCharacter && Value.Get<bool>() && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::Ragdoll, 1.0f);
 		PossessedCharacter->RagdollAction();
 	}
 }
 
 void AALSPlayerController::VelocityDirectionAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter && Value.Get<bool>())
+	if (PossessedCharacter && Value.Get<bool>() && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::VelocityDirection, 1.0f);
 		PossessedCharacter->VelocityDirectionAction();
 	}
 }
 
 void AALSPlayerController::LookingDirectionAction(const FInputActionValue& Value)
 {
-	if (PossessedCharacter && Value.Get<bool>())
+	if (PossessedCharacter && Value.Get<bool>() && CanForwardInput())
 	{
+		RecordInput(EALSReplayInputAction::LookingDirection, 1.0f);
 		PossessedCharacter->LookingDirectionAction();
 	}
 }
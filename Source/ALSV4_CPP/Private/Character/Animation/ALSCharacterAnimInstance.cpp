@@ -5,7 +5,10 @@
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Character/ALSBaseCharacter.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSLocomotionCore.h"
+#include "Library/ALSStats.h"
 #include "Components/ALSDebugComponent.h"
+#include "Subsystems/ALSSceneQuerySubsystem.h"
 
 #include "Curves/CurveFloat.h"
 #include "Curves/CurveVector.h"
@@ -15,6 +18,12 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 
+DECLARE_CYCLE_STAT(TEXT("Anim Update"), STAT_ALS_AnimUpdate, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Aiming Values"), STAT_ALS_AnimAimingValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Layer Values"), STAT_ALS_AnimLayerValues, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Foot IK"), STAT_ALS_AnimFootIK, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Anim Movement Values"), STAT_ALS_AnimMovementValues, STATGROUP_ALS);
+
 
 static const FName NAME_BasePose_CLF(TEXT("BasePose_CLF"));
 static const FName NAME_BasePose_N(TEXT("BasePose_N"));
@@ -66,6 +75,33 @@ void UALSCharacterAnimInstance::NativeBeginPlay()
 	}
 }
 
+void UALSCharacterAnimInstance::ResetAnimationValues()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(OnPivotTimer);
+		World->GetTimerManager().ClearTimer(PlayDynamicTransitionTimer);
+		World->GetTimerManager().ClearTimer(OnJumpedTimer);
+	}
+	bCanPlayDynamicTransition = true;
+
+	CharacterInformation = FALSAnimCharacterInformation();
+	Grounded = FALSAnimGraphGrounded();
+	VelocityBlend = FALSVelocityBlend();
+	LeanAmount = FALSLeanAmount();
+	RelativeAccelerationAmount = FVector::ZeroVector;
+	GroundedEntryState = EALSGroundedEntryState::None;
+	MovementDirection = EALSMovementDirection::Forward;
+	InAir = FALSAnimGraphInAir();
+	AimingValues = FALSAnimGraphAimingValues();
+	SmoothedAimingAngle = FVector2D::ZeroVector;
+	FlailRate = 0.0f;
+	LayerBlendingValues = FALSAnimGraphLayerBlending();
+	FootIKValues = FALSAnimGraphFootIK();
+	TurnInPlaceValues.ElapsedDelayTime = 0.0f;
+	BoneIndexCache.Reset();
+}
+
 void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeUpdateAnimation(DeltaSeconds);
@@ -75,6 +111,10 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		return;
 	}
 
+	SCOPE_CYCLE_COUNTER(STAT_ALS_AnimUpdate);
+	CSV_SCOPED_TIMING_STAT(ALS, AnimUpdate);
+	ALS_SCOPED_STAGE_TIMING(AnimUpdate);
+
 	// Update rest of character information. Others are reflected into anim bp when they're set inside character class
 	CharacterInformation.MovementInputAmount = Character->GetMovementInputAmount();
 	CharacterInformation.bHasMovementInput = Character->HasMovementInput();
@@ -97,9 +137,19 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 	OverlayState = Character->GetOverlayState();
 	GroundedEntryState = Character->GetGroundedEntryState();
 
-	UpdateAimingValues(DeltaSeconds);
-	UpdateLayerValues();
-	UpdateFootIK(DeltaSeconds);
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ALS_AnimAimingValues);
+		UpdateAimingValues(DeltaSeconds);
+	}
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ALS_AnimLayerValues);
+		UpdateLayerValues();
+	}
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ALS_AnimFootIK);
+		CSV_SCOPED_TIMING_STAT(ALS, AnimFootIK);
+		UpdateFootIK(DeltaSeconds);
+	}
 
 	if (MovementState.Grounded())
 	{
@@ -118,6 +168,7 @@ void UALSCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		if (Grounded.bShouldMove)
 		{
 			// Do While Moving
+			SCOPE_CYCLE_COUNTER(STAT_ALS_AnimMovementValues);
 			UpdateMovementValues(DeltaSeconds);
 			UpdateRotationValues();
 		}
@@ -381,8 +432,8 @@ void UALSCharacterAnimInstance::SetFootLocking(float DeltaSeconds, FName EnableF
 	// Step 3: If the Foot Lock curve equals 1, save the new lock location and rotation in component space as the target.
 	if (CurFootLockAlpha >= 0.99f)
 	{
-		const FTransform& OwnerTransform =
-			GetOwningComponent()->GetSocketTransform(IKFootBone, RTS_Component);
+		const FTransform OwnerTransform =
+			BoneIndexCache.GetSocketTransform(GetOwningComponent(), IKFootBone, RTS_Component);
 		CurFootLockLoc = OwnerTransform.GetLocation();
 		CurFootLockRot = OwnerTransform.Rotator();
 	}
@@ -474,23 +525,21 @@ void UALSCharacterAnimInstance::SetFootOffsets(float DeltaSeconds, FName EnableF
 	// Step 1: Trace downward from the foot location to find the geometry.
 	// If the surface is walkable, save the Impact Location and Normal.
 	USkeletalMeshComponent* OwnerComp = GetOwningComponent();
-	FVector IKFootFloorLoc = OwnerComp->GetSocketLocation(IKFootBone);
-	IKFootFloorLoc.Z = OwnerComp->GetSocketLocation(RootBone).Z;
+	FVector IKFootFloorLoc = BoneIndexCache.GetSocketLocation(OwnerComp, IKFootBone);
+	IKFootFloorLoc.Z = BoneIndexCache.GetSocketLocation(OwnerComp, RootBone).Z;
 
 	UWorld* World = GetWorld();
 	check(World);
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(Character);
+	const FCollisionQueryParams Params = UALSSceneQuerySubsystem::MakeGroundProbeParams(Character);
 
 	const FVector TraceStart = IKFootFloorLoc + FVector(0.0, 0.0, Config.IK_TraceDistanceAboveFoot);
 	const FVector TraceEnd = IKFootFloorLoc - FVector(0.0, 0.0, Config.IK_TraceDistanceBelowFoot);
 
 	FHitResult HitResult;
-	const bool bHit = World->LineTraceSingleByChannel(HitResult,
-	                                                  TraceStart,
-	                                                  TraceEnd,
-	                                                  ECC_Visibility, Params);
+	const bool bHit = UALSSceneQuerySubsystem::ProbeGround(World, EALSSceneQueryType::FootIK, Character,
+	                                                       GetTypeHash(IKFootBone), HitResult, TraceStart, TraceEnd,
+	                                                       UALSSceneQuerySubsystem::GroundProbeChannel, Params);
 
 	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
 	{
@@ -585,9 +634,9 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 	// (determined via a virtual bone) exceeds a threshold. If it does, play an additive transition animation on that foot.
 	// The currently set transition plays the second half of a 2 foot transition animation, so that only a single foot moves.
 	// Because only the IK_Foot bone can be locked, the separate virtual bone allows the system to know its desired location when locked.
-	FTransform SocketTransformA = GetOwningComponent()->GetSocketTransform(IkFootL_BoneName, RTS_Component);
-	FTransform SocketTransformB = GetOwningComponent()->GetSocketTransform(
-		NAME_VB___foot_target_l, RTS_Component);
+	const USkeletalMeshComponent* OwnerComp = GetOwningComponent();
+	FTransform SocketTransformA = BoneIndexCache.GetSocketTransform(OwnerComp, IkFootL_BoneName, RTS_Component);
+	FTransform SocketTransformB = BoneIndexCache.GetSocketTransform(OwnerComp, NAME_VB___foot_target_l, RTS_Component);
 	float Distance = (SocketTransformB.GetLocation() - SocketTransformA.GetLocation()).Size();
 	if (Distance > Config.DynamicTransitionThreshold)
 	{
@@ -600,8 +649,8 @@ void UALSCharacterAnimInstance::DynamicTransitionCheck()
 		PlayDynamicTransition(0.1f, Params);
 	}
 
-	SocketTransformA = GetOwningComponent()->GetSocketTransform(IkFootR_BoneName, RTS_Component);
-	SocketTransformB = GetOwningComponent()->GetSocketTransform(NAME_VB___foot_target_r, RTS_Component);
+	SocketTransformA = BoneIndexCache.GetSocketTransform(OwnerComp, IkFootR_BoneName, RTS_Component);
+	SocketTransformB = BoneIndexCache.GetSocketTransform(OwnerComp, NAME_VB___foot_target_r, RTS_Component);
 	Distance = (SocketTransformB.GetLocation() - SocketTransformA.GetLocation()).Size();
 	if (Distance > Config.DynamicTransitionThreshold)
 	{
@@ -698,14 +747,13 @@ FALSVelocityBlend UALSCharacterAnimInstance::CalculateVelocityBlend() const
 	// directional blending than a standard blendspace.
 	const FVector LocRelativeVelocityDir =
 		CharacterInformation.CharacterActorRotation.UnrotateVector(CharacterInformation.Velocity.GetSafeNormal(0.1f));
-	const float Sum = FMath::Abs(LocRelativeVelocityDir.X) + FMath::Abs(LocRelativeVelocityDir.Y) +
-		FMath::Abs(LocRelativeVelocityDir.Z);
-	const FVector RelativeDir = LocRelativeVelocityDir / Sum;
+	const ALSLocomotionCore::FVelocityBlend Blend = ALSLocomotionCore::CalculateVelocityBlend(
+		LocRelativeVelocityDir.X, LocRelativeVelocityDir.Y, LocRelativeVelocityDir.Z);
 	FALSVelocityBlend Result;
-	Result.F = FMath::Clamp(RelativeDir.X, 0.0f, 1.0f);
-	Result.B = FMath::Abs(FMath::Clamp(RelativeDir.X, -1.0f, 0.0f));
-	Result.L = FMath::Abs(FMath::Clamp(RelativeDir.Y, -1.0f, 0.0f));
-	Result.R = FMath::Clamp(RelativeDir.Y, 0.0f, 1.0f);
+	Result.F = Blend.F;
+	Result.B = Blend.B;
+	Result.L = Blend.L;
+	Result.R = Blend.R;
 	return Result;
 }
 
@@ -813,8 +861,10 @@ float UALSCharacterAnimInstance::CalculateLandPrediction() const
 	FHitResult HitResult;
 	const FCollisionShape CapsuleCollisionShape = FCollisionShape::MakeCapsule(CapsuleComp->GetUnscaledCapsuleRadius(),
 	                                                                           CapsuleComp->GetUnscaledCapsuleHalfHeight());
-	const bool bHit = World->SweepSingleByChannel(HitResult, CapsuleWorldLoc, CapsuleWorldLoc + TraceLength, FQuat::Identity,
-	                                              ECC_Visibility, CapsuleCollisionShape, Params);
+	const bool bHit = UALSSceneQuerySubsystem::SweepSingleByChannel(World, EALSSceneQueryType::LandPrediction, Character, 0,
+	                                                                HitResult, CapsuleWorldLoc,
+	                                                                CapsuleWorldLoc + TraceLength, ECC_Visibility,
+	                                                                CapsuleCollisionShape, Params);
 
 	if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
 	{
@@ -859,14 +909,15 @@ EALSMovementDirection UALSCharacterAnimInstance::CalculateMovementDirection() co
 	// Calculate the Movement Direction. This value represents the direction the character is moving relative to the camera
 	// during the Looking Direction / Aiming rotation modes, and is used in the Cycle Blending Anim Layers to blend to the
 	// appropriate directional states.
-	if (Gait.Sprinting() || RotationMode.VelocityDirection())
-	{
-		return EALSMovementDirection::Forward;
-	}
-
+	const EALSMovementDirection CurrentDirection = MovementDirection;
+	const EALSGait CurrentGait = Gait;
+	const EALSRotationMode CurrentRotationMode = RotationMode;
 	FRotator Delta = CharacterInformation.Velocity.ToOrientationRotator() - CharacterInformation.AimingRotation;
 	Delta.Normalize();
-	return UALSMathLibrary::CalculateQuadrant(MovementDirection, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Delta.Yaw);
+	return static_cast<EALSMovementDirection>(ALSLocomotionCore::CalculateMovementDirection(
+		static_cast<ALSLocomotionCore::EMovementDirection>(CurrentDirection),
+		static_cast<ALSLocomotionCore::EGait>(CurrentGait),
+		static_cast<ALSLocomotionCore::ERotationMode>(CurrentRotationMode), Delta.Yaw));
 }
 
 void UALSCharacterAnimInstance::TurnInPlace(FRotator TargetRotation, float PlayRateScale, float StartTime,
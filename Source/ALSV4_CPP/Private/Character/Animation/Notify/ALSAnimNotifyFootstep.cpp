@@ -11,10 +11,15 @@
 #include "Engine/DataTable.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
+#include "Components/ALSDebugComponent.h"
+#include "Subsystems/ALSSceneQuerySubsystem.h"
+#include "Library/ALSStats.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "NiagaraSystem.h"
 #include "NiagaraFunctionLibrary.h"
 
+DECLARE_CYCLE_STAT(TEXT("Footstep Notify"), STAT_ALS_FootstepNotify, STATGROUP_ALS);
+
 
 const FName NAME_Mask_FootstepSound(TEXT("Mask_FootstepSound"));
 
@@ -26,6 +31,10 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 {
 	Super::Notify(MeshComp, Animation, EventReference);
 
+	SCOPE_CYCLE_COUNTER(STAT_ALS_FootstepNotify);
+	CSV_SCOPED_TIMING_STAT(ALS, FootstepNotify);
+	ALS_SCOPED_STAGE_TIMING(Footsteps);
+
 	if (!MeshComp)
 	{
 		return;
@@ -46,10 +55,19 @@ void UALSAnimNotifyFootstep::Notify(USkeletalMeshComponent* MeshComp, UAnimSeque
 		const FRotator FootRotation = MeshComp->GetSocketRotation(FootSocketName);
 		const FVector TraceEnd = FootLocation - MeshOwner->GetActorUpVector() * TraceLength;
 
+		// Same params as foot IK, so the footstep reuses the foot IK probe of the same foot
+		const FCollisionQueryParams Params = UALSSceneQuerySubsystem::MakeGroundProbeParams(MeshOwner);
+
 		FHitResult Hit;
+		const bool bHit = UALSSceneQuerySubsystem::ProbeGround(World, EALSSceneQueryType::Footstep, MeshOwner,
+		                                                       GetTypeHash(FootSocketName), Hit, FootLocation, TraceEnd,
+		                                                       UEngineTypes::ConvertToCollisionChannel(TraceChannel),
+		                                                       Params);
+
+		UALSDebugComponent::DrawDebugLineTraceSingle(World, FootLocation, TraceEnd, DrawDebugType, bHit, Hit,
+		                                             FLinearColor::Red, FLinearColor::Green, 5.0f);
 
-		if (UKismetSystemLibrary::LineTraceSingle(MeshOwner /*used by bIgnoreSelf*/, FootLocation, TraceEnd, TraceChannel, true /*bTraceComplex*/, MeshOwner->Children,
-		                                          DrawDebugType, Hit, true /*bIgnoreSelf*/))
+		if (bHit)
 		{
 			if (!Hit.PhysMaterial.Get())
 			{
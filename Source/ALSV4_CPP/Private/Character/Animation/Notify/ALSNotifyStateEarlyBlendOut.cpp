@@ -4,47 +4,76 @@
 
 #include "Character/Animation/Notify/ALSNotifyStateEarlyBlendOut.h"
 
+#include "Animation/ActiveMontageInstanceScope.h"
 #include "Animation/AnimInstance.h"
 
 #include "Character/ALSBaseCharacter.h"
 
-void UALSNotifyStateEarlyBlendOut::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
-                                              float FrameDeltaTime, const FAnimNotifyEventReference& EventReference)
+static int32 GetMontageInstanceID(const FAnimNotifyEventReference& EventReference)
 {
-	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
+	const UE::Anim::FAnimNotifyMontageInstanceContext* MontageContext =
+		EventReference.GetContextData<UE::Anim::FAnimNotifyMontageInstanceContext>();
+	return MontageContext ? MontageContext->MontageInstanceID : INDEX_NONE;
+}
+
+void UALSNotifyStateEarlyBlendOut::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+                                               float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 
-	if (!MeshComp || !MeshComp->GetAnimInstance())
+	if (!MeshComp || !MeshComp->GetAnimInstance() || !(bCheckMovementState || bCheckStance || bCheckMovementInput))
 	{
 		return;
 	}
 
 	UAnimInstance* AnimInstance = MeshComp->GetAnimInstance();
 	AALSBaseCharacter* OwnerCharacter = Cast<AALSBaseCharacter>(MeshComp->GetOwner());
-	if (!OwnerCharacter || !AnimInstance)
+	if (!OwnerCharacter)
 	{
 		return;
 	}
 
-	bool bStopMontage = false;
-	if (bCheckMovementState && OwnerCharacter->GetMovementState() == MovementStateEquals)
-	{
-		bStopMontage = true;
-	}
-	else if (bCheckStance && OwnerCharacter->GetStance() == StanceEquals)
+	if (ShouldBlendOut(OwnerCharacter))
 	{
-		bStopMontage = true;
-	}
-	else if (bCheckMovementInput && OwnerCharacter->HasMovementInput())
-	{
-		bStopMontage = true;
+		AnimInstance->Montage_Stop(BlendOutTime, ThisMontage);
+		return;
 	}
 
-	if (bStopMontage)
+	// Notifies begin and end on the game thread, where the character changes its states and fires the events,
+	// so threaded anim updates never run the listener. Both the anim instance and the notify can go away
+	// before NotifyEnd if the montage asset is unloaded or the mesh destroyed.
+	const TWeakObjectPtr<UALSNotifyStateEarlyBlendOut> WeakThis(this);
+	OwnerCharacter->AddStateEventListener(
+		this, GetMontageInstanceID(EventReference),
+		FCharacterStateEventSignature::FDelegate::CreateWeakLambda(
+			AnimInstance, [WeakThis, AnimInstance](AALSBaseCharacter* Character)
+			{
+				const UALSNotifyStateEarlyBlendOut* Notify = WeakThis.Get();
+				if (Notify && Notify->ShouldBlendOut(Character))
+				{
+					AnimInstance->Montage_Stop(Notify->BlendOutTime, Notify->ThisMontage);
+				}
+			}));
+}
+
+void UALSNotifyStateEarlyBlendOut::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+                                             const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+
+	if (AALSBaseCharacter* OwnerCharacter = MeshComp ? Cast<AALSBaseCharacter>(MeshComp->GetOwner()) : nullptr)
 	{
-		AnimInstance->Montage_Stop(BlendOutTime, ThisMontage);
+		OwnerCharacter->RemoveStateEventListener(this, GetMontageInstanceID(EventReference));
 	}
 }
 
+bool UALSNotifyStateEarlyBlendOut::ShouldBlendOut(const AALSBaseCharacter* Character) const
+{
+	return (bCheckMovementState && Character->GetMovementState() == MovementStateEquals) ||
+		(bCheckStance && Character->GetStance() == StanceEquals) ||
+		(bCheckMovementInput && Character->HasMovementInput());
+}
+
 FString UALSNotifyStateEarlyBlendOut::GetNotifyName_Implementation() const
 {
 	return FString(TEXT("Early Blend Out"));
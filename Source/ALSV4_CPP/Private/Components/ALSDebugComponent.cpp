@@ -199,7 +199,7 @@ void UALSDebugComponent::ToggleDebugMesh()
 	else
 	{
 		DefaultSkeletalMesh = OwnerCharacter->GetMesh()->GetSkeletalMeshAsset();
-		OwnerCharacter->SetVisibleMesh(DebugSkeletalMesh);
+		OwnerCharacter->SetVisibleMeshAsync(DebugSkeletalMesh);
 	}
 	bDebugMeshVisible = !bDebugMeshVisible;
 }
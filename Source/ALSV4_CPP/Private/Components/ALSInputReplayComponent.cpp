@@ -0,0 +1,387 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Components/ALSInputReplayComponent.h"
+
+#include "Character/ALSBaseCharacter.h"
+
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+
+static constexpr uint32 ALSInputReplayMagic = 0x414C5352; // "ALSR"
+static constexpr int32 ALSInputReplayVersion = 1;
+
+/* World of the character replaying the -ALSReplay command line, only one character picks it up at a time */
+static TWeakObjectPtr<const UWorld> ALSCommandLineReplayWorld;
+
+static FDelegateHandle ALSCommandLineReplayCleanupHandle;
+
+/* Frees the command line replay once its world is torn down, so the next PIE session replays it again */
+static void ReleaseCommandLineReplay(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (ALSCommandLineReplayWorld.Get(true) == World)
+	{
+		ALSCommandLineReplayWorld.Reset();
+	}
+}
+
+UALSInputReplayComponent::UALSInputReplayComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UALSInputReplayComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	OwnerCharacter = Cast<AALSBaseCharacter>(GetOwner());
+
+	FString ReplayFile;
+	if (OwnerCharacter && !ALSCommandLineReplayWorld.IsValid() &&
+		FParse::Value(FCommandLine::Get(), TEXT("ALSReplay="), ReplayFile))
+	{
+		ALSCommandLineReplayWorld = GetWorld();
+		if (!ALSCommandLineReplayCleanupHandle.IsValid())
+		{
+			ALSCommandLineReplayCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&ReleaseCommandLineReplay);
+		}
+		bExitAfterReplay = FParse::Param(FCommandLine::Get(), TEXT("ALSReplayExit"));
+		if (!LoadRecording(ReplayFile) || !StartReplay())
+		{
+			UE_LOG(LogTemp, Error, TEXT("ALS input replay: could not replay %s"), *ReplayFile);
+			if (bExitAfterReplay)
+			{
+				FPlatformMisc::RequestExit(false, TEXT("ALSInputReplay"));
+			}
+		}
+	}
+}
+
+void UALSInputReplayComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopRecording();
+	StopReplay();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UALSInputReplayComponent::StartRecording()
+{
+	if (!OwnerCharacter || bRecording || bReplaying)
+	{
+		return;
+	}
+
+	Frames.Reset();
+	PendingFrame = FALSReplayInputFrame();
+	StartTransform = OwnerCharacter->GetActorTransform();
+	StartControlRotation = OwnerCharacter->GetControlRotation();
+
+	WorldTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+		this, &UALSInputReplayComponent::OnWorldPostActorTick);
+	bRecording = true;
+}
+
+void UALSInputReplayComponent::StopRecording()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FWorldDelegates::OnWorldPostActorTick.Remove(WorldTickHandle);
+	WorldTickHandle.Reset();
+	bRecording = false;
+}
+
+bool UALSInputReplayComponent::StartReplay()
+{
+	if (!OwnerCharacter || bRecording || bReplaying || Frames.Num() == 0)
+	{
+		return false;
+	}
+
+	OwnerCharacter->SetActorTransform(StartTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	OwnerCharacter->GetCharacterMovement()->StopMovementImmediately();
+	if (AController* Controller = OwnerCharacter->GetController())
+	{
+		Controller->SetControlRotation(StartControlRotation);
+	}
+
+	bPrevUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PrevFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	SetReplayDeltaTime(Frames[0].DeltaTime);
+
+	ReplayFrameIndex = 0;
+	ReplayStartTime = FPlatformTime::Seconds();
+	WorldTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(
+		this, &UALSInputReplayComponent::OnWorldPreActorTick);
+	bReplaying = true;
+	return true;
+}
+
+void UALSInputReplayComponent::StopReplay()
+{
+	if (!bReplaying)
+	{
+		return;
+	}
+
+	FWorldDelegates::OnWorldPreActorTick.Remove(WorldTickHandle);
+	WorldTickHandle.Reset();
+	FApp::SetUseFixedTimeStep(bPrevUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PrevFixedDeltaTime);
+	bReplaying = false;
+}
+
+void UALSInputReplayComponent::RecordInput(EALSReplayInputAction Action, float Value)
+{
+	if (bRecording)
+	{
+		PendingFrame.Events.Add({Action, Value});
+	}
+}
+
+void UALSInputReplayComponent::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	PendingFrame.DeltaTime = DeltaSeconds;
+	Frames.Add(MoveTemp(PendingFrame));
+	PendingFrame = FALSReplayInputFrame();
+}
+
+void UALSInputReplayComponent::OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// The previous frame ticked with the last recorded input, the character is in its final state now
+	if (ReplayFrameIndex >= Frames.Num() || !IsValid(OwnerCharacter))
+	{
+		FinishReplay();
+		return;
+	}
+
+	for (const FALSReplayInputEvent& Event : Frames[ReplayFrameIndex].Events)
+	{
+		DispatchEvent(Event);
+	}
+
+	++ReplayFrameIndex;
+	if (Frames.IsValidIndex(ReplayFrameIndex))
+	{
+		SetReplayDeltaTime(Frames[ReplayFrameIndex].DeltaTime);
+	}
+}
+
+void UALSInputReplayComponent::DispatchEvent(const FALSReplayInputEvent& Event) const
+{
+	// Mirrors what AALSPlayerController forwards to the possessed character
+	const bool bPressed = Event.Value != 0.0f;
+	switch (Event.Action)
+	{
+	case EALSReplayInputAction::ForwardMovement:
+		OwnerCharacter->ForwardMovementAction(Event.Value);
+		break;
+	case EALSReplayInputAction::RightMovement:
+		OwnerCharacter->RightMovementAction(Event.Value);
+		break;
+	case EALSReplayInputAction::CameraUp:
+		OwnerCharacter->CameraUpAction(Event.Value);
+		break;
+	case EALSReplayInputAction::CameraRight:
+		OwnerCharacter->CameraRightAction(Event.Value);
+		break;
+	case EALSReplayInputAction::Jump:
+		OwnerCharacter->JumpAction(bPressed);
+		break;
+	case EALSReplayInputAction::Sprint:
+		OwnerCharacter->SprintAction(bPressed);
+		break;
+	case EALSReplayInputAction::Aim:
+		OwnerCharacter->AimAction(bPressed);
+		break;
+	case EALSReplayInputAction::CameraTap:
+		OwnerCharacter->CameraTapAction();
+		break;
+	case EALSReplayInputAction::CameraHeld:
+		OwnerCharacter->CameraHeldAction();
+		break;
+	case EALSReplayInputAction::Stance:
+		OwnerCharacter->StanceAction();
+		break;
+	case EALSReplayInputAction::Walk:
+		OwnerCharacter->WalkAction();
+		break;
+	case EALSReplayInputAction::Ragdoll:
+		OwnerCharacter->RagdollAction();
+		break;
+	case EALSReplayInputAction::VelocityDirection:
+		OwnerCharacter->VelocityDirectionAction();
+		break;
+	case EALSReplayInputAction::LookingDirection:
+		OwnerCharacter->LookingDirectionAction();
+		break;
+	default:
+		break;
+	}
+}
+
+void UALSInputReplayComponent::SetReplayDeltaTime(float DeltaTime) const
+{
+	FApp::SetFixedDeltaTime(ReplayFixedDeltaTime > 0.0f ? ReplayFixedDeltaTime : DeltaTime);
+}
+
+void UALSInputReplayComponent::FinishReplay()
+{
+	FALSReplayChecksum Checksum = ComputeChecksum();
+	Checksum.Frames = ReplayFrameIndex;
+	Checksum.ElapsedSeconds = static_cast<float>(FPlatformTime::Seconds() - ReplayStartTime);
+
+	StopReplay();
+
+	UE_LOG(LogTemp, Display, TEXT("ALS input replay: %d frames in %.3fs, transform checksum %08X, state checksum %08X"),
+	       Checksum.Frames, Checksum.ElapsedSeconds, static_cast<uint32>(Checksum.TransformChecksum),
+	       static_cast<uint32>(Checksum.StateChecksum));
+
+	OnReplayFinished.Broadcast(Checksum);
+
+	if (bExitAfterReplay)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("ALSInputReplay"));
+	}
+}
+
+FALSReplayChecksum UALSInputReplayComponent::ComputeChecksum() const
+{
+	FALSReplayChecksum Checksum;
+	Checksum.Frames = Frames.Num();
+	if (!OwnerCharacter)
+	{
+		return Checksum;
+	}
+
+	const double Grid = FMath::Max(static_cast<double>(ChecksumTolerance), UE_DOUBLE_KINDA_SMALL_NUMBER);
+	const FVector Location = OwnerCharacter->GetActorLocation();
+	const FRotator Rotation = OwnerCharacter->GetActorRotation();
+	const FVector Velocity = OwnerCharacter->GetVelocity();
+	const int64 Transform[] = {
+		FMath::RoundToInt64(Location.X / Grid), FMath::RoundToInt64(Location.Y / Grid),
+		FMath::RoundToInt64(Location.Z / Grid), FMath::RoundToInt64(Rotation.Pitch / Grid),
+		FMath::RoundToInt64(Rotation.Yaw / Grid), FMath::RoundToInt64(Rotation.Roll / Grid),
+		FMath::RoundToInt64(Velocity.X / Grid), FMath::RoundToInt64(Velocity.Y / Grid),
+		FMath::RoundToInt64(Velocity.Z / Grid)
+	};
+	Checksum.TransformChecksum = static_cast<int32>(FCrc::MemCrc32(Transform, sizeof(Transform)));
+
+	const uint8 State[] = {
+		static_cast<uint8>(OwnerCharacter->GetMovementState()),
+		static_cast<uint8>(OwnerCharacter->GetMovementAction()),
+		static_cast<uint8>(OwnerCharacter->GetGait()),
+		static_cast<uint8>(OwnerCharacter->GetStance()),
+		static_cast<uint8>(OwnerCharacter->GetRotationMode()),
+		static_cast<uint8>(OwnerCharacter->GetViewMode()),
+		static_cast<uint8>(OwnerCharacter->GetOverlayState())
+	};
+	Checksum.StateChecksum = static_cast<int32>(FCrc::MemCrc32(State, sizeof(State)));
+
+	return Checksum;
+}
+
+bool UALSInputReplayComponent::SaveRecording(const FString& FileName) const
+{
+	FBufferArchive Ar;
+	uint32 Magic = ALSInputReplayMagic;
+	int32 Version = ALSInputReplayVersion;
+	FTransform Transform = StartTransform;
+	FRotator ControlRotation = StartControlRotation;
+	int32 NumFrames = Frames.Num();
+	Ar << Magic << Version << Transform << ControlRotation << NumFrames;
+
+	for (const FALSReplayInputFrame& Frame : Frames)
+	{
+		float DeltaTime = Frame.DeltaTime;
+		int32 NumEvents = Frame.Events.Num();
+		Ar << DeltaTime << NumEvents;
+		for (const FALSReplayInputEvent& Event : Frame.Events)
+		{
+			uint8 Action = static_cast<uint8>(Event.Action);
+			float Value = Event.Value;
+			Ar << Action << Value;
+		}
+	}
+
+	return FFileHelper::SaveArrayToFile(Ar, *FileName);
+}
+
+bool UALSInputReplayComponent::LoadRecording(const FString& FileName)
+{
+	TArray<uint8> Data;
+	if (bReplaying || !FFileHelper::LoadFileToArray(Data, *FileName))
+	{
+		return false;
+	}
+
+	FMemoryReader Ar(Data);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 NumFrames = 0;
+	FTransform Transform;
+	FRotator ControlRotation;
+	Ar << Magic << Version;
+	if (Magic != ALSInputReplayMagic || Version != ALSInputReplayVersion)
+	{
+		return false;
+	}
+
+	Ar << Transform << ControlRotation << NumFrames;
+	if (Ar.IsError() || NumFrames < 0 || NumFrames > Ar.TotalSize() - Ar.Tell())
+	{
+		return false;
+	}
+
+	TArray<FALSReplayInputFrame> LoadedFrames;
+	LoadedFrames.SetNum(NumFrames);
+	for (FALSReplayInputFrame& Frame : LoadedFrames)
+	{
+		int32 NumEvents = 0;
+		Ar << Frame.DeltaTime << NumEvents;
+		if (Ar.IsError() || NumEvents < 0 || NumEvents > Ar.TotalSize() - Ar.Tell())
+		{
+			return false;
+		}
+
+		Frame.Events.SetNum(NumEvents);
+		for (FALSReplayInputEvent& Event : Frame.Events)
+		{
+			uint8 Action = 0;
+			Ar << Action << Event.Value;
+			Event.Action = static_cast<EALSReplayInputAction>(Action);
+		}
+	}
+
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+	StartTransform = Transform;
+	StartControlRotation = ControlRotation;
+	Frames = MoveTemp(LoadedFrames);
+	return true;
+}
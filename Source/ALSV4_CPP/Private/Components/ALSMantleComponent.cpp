@@ -8,10 +8,15 @@
 #include "Character/ALSCharacter.h"
 #include "Character/Animation/ALSCharacterAnimInstance.h"
 #include "Components/ALSDebugComponent.h"
+#include "Subsystems/ALSSceneQuerySubsystem.h"
 #include "Curves/CurveVector.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Library/ALSMathLibrary.h"
+#include "Library/ALSStats.h"
+#include "Library/ALSTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Mantle Check"), STAT_ALS_MantleCheck, STATGROUP_ALS);
 
 
 const FName NAME_MantleEnd(TEXT("MantleEnd"));
@@ -88,11 +93,17 @@ void UALSMantleComponent::MantleStart(float MantleHeight, const FALSComponentAnd
 		Cast<AALSCharacter>(OwnerCharacter)->ClearHeldObject();
 	}
 
+	ALS_TRACE_STATE_TRANSITION(OwnerCharacter, EALSTraceTransition::MantleStart, 0, MantleType);
+
 	// Disable ticking during mantle
 	SetComponentTickEnabledAsync(false);
 
 	// Step 1: Get the Mantle Asset and use it to set the new Mantle Params.
-	const FALSMantleAsset MantleAsset = GetMantleAsset(MantleType, OwnerCharacter->GetOverlayState());
+	FALSMantleAsset MantleAsset;
+	if (!OwnerCharacter->FindMantleActionAsset(MantleType, MantleAsset))
+	{
+		MantleAsset = GetMantleAsset(MantleType, OwnerCharacter->GetOverlayState());
+	}
 	check(MantleAsset.PositionCorrectionCurve)
 
 	MantleParams.AnimMontage = MantleAsset.AnimMontage;
@@ -150,6 +161,10 @@ void UALSMantleComponent::MantleStart(float MantleHeight, const FALSComponentAnd
 
 bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettings, EDrawDebugTrace::Type DebugType)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ALS_MantleCheck);
+	CSV_SCOPED_TIMING_STAT(ALS, MantleCheck);
+	ALS_SCOPED_STAGE_TIMING(Mantle);
+
 	if (!OwnerCharacter)
 	{
 		return false;
@@ -173,8 +188,10 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 	FHitResult HitResult;
 	{
 		const FCollisionShape CapsuleCollisionShape = FCollisionShape::MakeCapsule(TraceSettings.ForwardTraceRadius, HalfHeight);
-		const bool bHit = World->SweepSingleByProfile(HitResult, TraceStart, TraceEnd, FQuat::Identity, MantleObjectDetectionProfile,
-	                                                  CapsuleCollisionShape, Params);
+		const bool bHit = UALSSceneQuerySubsystem::SweepSingleByProfile(World, EALSSceneQueryType::Mantle, OwnerCharacter, 0,
+		                                                                HitResult, TraceStart, TraceEnd,
+		                                                                MantleObjectDetectionProfile,
+		                                                                CapsuleCollisionShape, Params);
 
 		if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
 		{
@@ -219,9 +236,10 @@ bool UALSMantleComponent::MantleCheck(const FALSMantleTraceSettings& TraceSettin
 
 	{
 		const FCollisionShape SphereCollisionShape = FCollisionShape::MakeSphere(TraceSettings.DownwardTraceRadius);
-		const bool bHit = World->SweepSingleByChannel(HitResult, DownwardTraceStart, DownwardTraceEnd, FQuat::Identity,
-	                                                  WalkableSurfaceDetectionChannel, SphereCollisionShape,
-	                                                  Params);
+		const bool bHit = UALSSceneQuerySubsystem::SweepSingleByChannel(World, EALSSceneQueryType::Mantle, OwnerCharacter, 1,
+		                                                                HitResult, DownwardTraceStart,
+		                                                                DownwardTraceEnd, WalkableSurfaceDetectionChannel,
+		                                                                SphereCollisionShape, Params);
 
 		if (ALSDebugComponent && ALSDebugComponent->GetShowTraces())
 		{
@@ -310,6 +328,8 @@ void UALSMantleComponent::Multicast_MantleStart_Implementation(float MantleHeigh
 // This function is called by "MantleTimeline" using BindUFunction in UALSMantleComponent::BeginPlay during the default settings initialization.
 void UALSMantleComponent::MantleUpdate(float BlendIn)
 {
+	ALS_SCOPED_STAGE_TIMING(Mantle);
+
 	if (!OwnerCharacter)
 	{
 		return;
@@ -376,6 +396,8 @@ void UALSMantleComponent::MantleUpdate(float BlendIn)
 
 void UALSMantleComponent::MantleEnd()
 {
+	ALS_TRACE_STATE_TRANSITION(OwnerCharacter, EALSTraceTransition::MantleEnd, 0, 0);
+
 	// Set the Character Movement Mode to Walking
 	if (OwnerCharacter)
 	{
@@ -383,7 +405,7 @@ void UALSMantleComponent::MantleEnd()
 
 		if (OwnerCharacter->IsA(AALSCharacter::StaticClass()))
 		{
-			Cast<AALSCharacter>(OwnerCharacter)->UpdateHeldObject();
+			Cast<AALSCharacter>(OwnerCharacter)->RefreshHeldObject();
 		}
 	}
 
@@ -391,6 +413,16 @@ void UALSMantleComponent::MantleEnd()
 	SetComponentTickEnabledAsync(true);
 }
 
+void UALSMantleComponent::ResetMantle()
+{
+	if (MantleTimeline && MantleTimeline->IsPlaying())
+	{
+		MantleTimeline->Stop();
+	}
+
+	SetComponentTickEnabled(true);
+}
+
 void UALSMantleComponent::OnOwnerJumpInput()
 {
 	// Check if character is able to do one of the special mantling
@@ -0,0 +1,74 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Library/ALSBoneIndexCache.h"
+
+#include "Components/SkinnedMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Engine/SkinnedAsset.h"
+
+
+void FALSBoneIndexCache::Reset()
+{
+	Entries.Reset();
+	CachedAsset.Reset();
+}
+
+FTransform FALSBoneIndexCache::GetSocketTransform(const USkinnedMeshComponent* Mesh, FName SocketName,
+                                                  ERelativeTransformSpace TransformSpace)
+{
+	check(Mesh);
+
+	// Leader pose meshes read their bones from another component, keep the engine path for them.
+	if (Mesh->LeaderPoseComponent.IsValid())
+	{
+		return Mesh->GetSocketTransform(SocketName, TransformSpace);
+	}
+
+	const FEntry& Entry = FindOrAddEntry(Mesh, SocketName);
+	const TArray<FTransform>& ComponentSpaceTransforms = Mesh->GetComponentSpaceTransforms();
+	if (!ComponentSpaceTransforms.IsValidIndex(Entry.BoneIndex) ||
+		(TransformSpace != RTS_World && TransformSpace != RTS_Component))
+	{
+		return Mesh->GetSocketTransform(SocketName, TransformSpace);
+	}
+
+	const FTransform ComponentTransform = Entry.LocalTransform * ComponentSpaceTransforms[Entry.BoneIndex];
+	return TransformSpace == RTS_World ? ComponentTransform * Mesh->GetComponentTransform() : ComponentTransform;
+}
+
+const FALSBoneIndexCache::FEntry& FALSBoneIndexCache::FindOrAddEntry(const USkinnedMeshComponent* Mesh,
+                                                                     FName SocketName)
+{
+	const USkinnedAsset* Asset = Mesh->GetSkinnedAsset();
+	if (CachedAsset.Get() != Asset)
+	{
+		Reset();
+		CachedAsset = Asset;
+	}
+
+	for (const FEntry& Entry : Entries)
+	{
+		if (Entry.Name == SocketName)
+		{
+			return Entry;
+		}
+	}
+
+	FEntry& NewEntry = Entries.AddDefaulted_GetRef();
+	NewEntry.Name = SocketName;
+
+	// Sockets are resolved to their parent bone and a fixed local offset, anything else is looked up as a bone.
+	if (const USkeletalMeshSocket* Socket = Mesh->GetSocketByName(SocketName))
+	{
+		NewEntry.BoneIndex = Mesh->GetBoneIndex(Socket->BoneName);
+		NewEntry.LocalTransform = Socket->GetSocketLocalTransform();
+	}
+	else
+	{
+		NewEntry.BoneIndex = Mesh->GetBoneIndex(SocketName);
+	}
+
+	return NewEntry;
+}
@@ -6,9 +6,86 @@
 
 
 #include "Library/ALSCharacterStructLibrary.h"
+#include "Library/ALSLocomotionCore.h"
 #include "Components/ALSDebugComponent.h"
+#include "Subsystems/ALSSceneQuerySubsystem.h"
 
 #include "Components/CapsuleComponent.h"
+#include "Math/VectorRegister.h"
+
+namespace ALSBatch
+{
+	constexpr int32 NumLanes = 4;
+
+	/** Load a block of up to four values, missing lanes are zero */
+	FORCEINLINE VectorRegister4Float Load(TArrayView<const float> Values, int32 Index, int32 Count)
+	{
+		if (Count == NumLanes)
+		{
+			return VectorLoad(Values.GetData() + Index);
+		}
+
+		float Block[NumLanes] = {0.0f, 0.0f, 0.0f, 0.0f};
+		FMemory::Memcpy(Block, Values.GetData() + Index, Count * sizeof(float));
+		return VectorLoad(Block);
+	}
+
+	FORCEINLINE void Store(const VectorRegister4Float& Register, TArrayView<float> Values, int32 Index, int32 Count)
+	{
+		if (Count == NumLanes)
+		{
+			VectorStore(Register, Values.GetData() + Index);
+			return;
+		}
+
+		float Block[NumLanes];
+		VectorStore(Register, Block);
+		FMemory::Memcpy(Values.GetData() + Index, Block, Count * sizeof(float));
+	}
+
+	/** Vector version of FRotator::NormalizeAxis, wraps the angles to (-180, 180] */
+	FORCEINLINE VectorRegister4Float NormalizeAxis(const VectorRegister4Float& Angles)
+	{
+		const VectorRegister4Float Turns = VectorCeil(VectorSubtract(VectorMultiply(Angles, VectorSetFloat1(1.0f / 360.0f)),
+		                                                             VectorSetFloat1(0.5f)));
+		return VectorNegateMultiplyAdd(Turns, VectorSetFloat1(360.0f), Angles);
+	}
+
+	/** Rotate X/Y by the negative yaw in degrees, same as FRotator(0, Yaw, 0).UnrotateVector */
+	FORCEINLINE void UnrotateByYaw(const VectorRegister4Float& Yaws, VectorRegister4Float& X, VectorRegister4Float& Y)
+	{
+		VectorRegister4Float Sin;
+		VectorRegister4Float Cos;
+		const VectorRegister4Float Radians = VectorMultiply(Yaws, VectorSetFloat1(UE_PI / 180.0f));
+		VectorSinCos(&Sin, &Cos, &Radians);
+		const VectorRegister4Float LocalX = VectorMultiplyAdd(X, Cos, VectorMultiply(Y, Sin));
+		const VectorRegister4Float LocalY = VectorNegateMultiplyAdd(X, Sin, VectorMultiply(Y, Cos));
+		X = LocalX;
+		Y = LocalY;
+	}
+
+	FORCEINLINE VectorRegister4Float Clamp(const VectorRegister4Float& Value, float Min, float Max)
+	{
+		return VectorMin(VectorMax(Value, VectorSetFloat1(Min)), VectorSetFloat1(Max));
+	}
+
+	/** Vector version of FMath::FInterpTo */
+	FORCEINLINE VectorRegister4Float InterpTo(const VectorRegister4Float& Current, const VectorRegister4Float& Target,
+	                                          float DeltaTime, float InterpSpeed)
+	{
+		if (InterpSpeed <= 0.0f)
+		{
+			return Target;
+		}
+
+		const VectorRegister4Float Dist = VectorSubtract(Target, Current);
+		const VectorRegister4Float Alpha = VectorSetFloat1(FMath::Clamp(DeltaTime * InterpSpeed, 0.0f, 1.0f));
+		const VectorRegister4Float Result = VectorMultiplyAdd(Dist, Alpha, Current);
+		const VectorRegister4Float bReached = VectorCompareLT(VectorMultiply(Dist, Dist),
+		                                                      VectorSetFloat1(UE_SMALL_NUMBER));
+		return VectorSelect(bReached, Target, Result);
+	}
+}
 
 FTransform UALSMathLibrary::MantleComponentLocalToWorld(const FALSComponentAndTransform& CompAndTransform)
 {
@@ -51,8 +128,9 @@ bool UALSMathLibrary::CapsuleHasRoomCheck(UCapsuleComponent* Capsule, FVector Ta
 
 	FHitResult HitResult;
 	const FCollisionShape SphereCollisionShape = FCollisionShape::MakeSphere(Radius);
-	const bool bHit = World->SweepSingleByChannel(HitResult, TraceStart, TraceEnd, FQuat::Identity,
-	                                              ECC_Visibility, FCollisionShape::MakeSphere(Radius), Params);
+	const bool bHit = UALSSceneQuerySubsystem::SweepSingleByChannel(World, EALSSceneQueryType::Mantle, Capsule->GetOwner(),
+	                                                                2, HitResult, TraceStart, TraceEnd, ECC_Visibility,
+	                                                                SphereCollisionShape, Params);
 
 	if (DrawDebugTrace)
 	{
@@ -73,11 +151,7 @@ bool UALSMathLibrary::CapsuleHasRoomCheck(UCapsuleComponent* Capsule, FVector Ta
 
 bool UALSMathLibrary::AngleInRange(float Angle, float MinAngle, float MaxAngle, float Buffer, bool IncreaseBuffer)
 {
-	if (IncreaseBuffer)
-	{
-		return Angle >= MinAngle - Buffer && Angle <= MaxAngle + Buffer;
-	}
-	return Angle >= MinAngle + Buffer && Angle <= MaxAngle - Buffer;
+	return ALSLocomotionCore::AngleInRange(Angle, MinAngle, MaxAngle, Buffer, IncreaseBuffer);
 }
 
 EALSMovementDirection UALSMathLibrary::CalculateQuadrant(EALSMovementDirection Current, float FRThreshold,
@@ -87,23 +161,149 @@ EALSMovementDirection UALSMathLibrary::CalculateQuadrant(EALSMovementDirection C
 {
 	// Take the input angle and determine its quadrant (direction). Use the current Movement Direction to increase or
 	// decrease the buffers on the angle ranges for each quadrant.
-	if (AngleInRange(Angle, FLThreshold, FRThreshold, Buffer,
-	                 Current != EALSMovementDirection::Forward && Current != EALSMovementDirection::Backward))
+	return static_cast<EALSMovementDirection>(ALSLocomotionCore::CalculateQuadrant(
+		static_cast<ALSLocomotionCore::EMovementDirection>(Current), FRThreshold, FLThreshold, BRThreshold,
+		BLThreshold, Buffer, Angle));
+}
+
+void UALSMathLibrary::CalculateYawDeltas(TArrayView<const float> YawsA, TArrayView<const float> YawsB,
+                                         TArrayView<float> OutDeltas)
+{
+	check(YawsA.Num() == YawsB.Num() && YawsA.Num() == OutDeltas.Num());
+
+	for (int32 Index = 0; Index < YawsA.Num(); Index += ALSBatch::NumLanes)
 	{
-		return EALSMovementDirection::Forward;
+		const int32 Count = FMath::Min(ALSBatch::NumLanes, YawsA.Num() - Index);
+		const VectorRegister4Float Delta = VectorSubtract(ALSBatch::Load(YawsA, Index, Count),
+		                                                  ALSBatch::Load(YawsB, Index, Count));
+		ALSBatch::Store(ALSBatch::NormalizeAxis(Delta), OutDeltas, Index, Count);
 	}
+}
 
-	if (AngleInRange(Angle, FRThreshold, BRThreshold, Buffer,
-	                 Current != EALSMovementDirection::Right && Current != EALSMovementDirection::Left))
+void UALSMathLibrary::CalculateQuadrants(TArrayView<EALSMovementDirection> Directions, TArrayView<const float> Angles,
+                                         float FRThreshold, float FLThreshold, float BRThreshold, float BLThreshold,
+                                         float Buffer)
+{
+	check(Directions.Num() == Angles.Num());
+
+	for (int32 Index = 0; Index < Angles.Num(); Index += ALSBatch::NumLanes)
 	{
-		return EALSMovementDirection::Right;
+		const int32 Count = FMath::Min(ALSBatch::NumLanes, Angles.Num() - Index);
+
+		// Forward / backward quadrants keep a smaller buffer while moving forward or backward, and the left / right
+		// quadrants while moving left or right, so the signed buffer of one pair is the negative of the other.
+		float SignedBuffers[ALSBatch::NumLanes] = {0.0f, 0.0f, 0.0f, 0.0f};
+		for (int32 Lane = 0; Lane < Count; ++Lane)
+		{
+			const EALSMovementDirection Current = Directions[Index + Lane];
+			const bool bForwardOrBackward = Current == EALSMovementDirection::Forward ||
+				Current == EALSMovementDirection::Backward;
+			SignedBuffers[Lane] = bForwardOrBackward ? -Buffer : Buffer;
+		}
+
+		const VectorRegister4Float Angle = ALSBatch::Load(Angles, Index, Count);
+		const VectorRegister4Float FBBuffer = VectorLoad(SignedBuffers);
+		const VectorRegister4Float FR = VectorSetFloat1(FRThreshold);
+		const VectorRegister4Float FL = VectorSetFloat1(FLThreshold);
+		const VectorRegister4Float BR = VectorSetFloat1(BRThreshold);
+		const VectorRegister4Float BL = VectorSetFloat1(BLThreshold);
+
+		const int32 ForwardMask = VectorMaskBits(VectorBitwiseAnd(
+			VectorCompareGE(Angle, VectorSubtract(FL, FBBuffer)),
+			VectorCompareLE(Angle, VectorAdd(FR, FBBuffer))));
+		const int32 RightMask = VectorMaskBits(VectorBitwiseAnd(
+			VectorCompareGE(Angle, VectorAdd(FR, FBBuffer)),
+			VectorCompareLE(Angle, VectorSubtract(BR, FBBuffer))));
+		const int32 LeftMask = VectorMaskBits(VectorBitwiseAnd(
+			VectorCompareGE(Angle, VectorAdd(BL, FBBuffer)),
+			VectorCompareLE(Angle, VectorSubtract(FL, FBBuffer))));
+
+		for (int32 Lane = 0; Lane < Count; ++Lane)
+		{
+			const int32 LaneBit = 1 << Lane;
+			EALSMovementDirection& Direction = Directions[Index + Lane];
+			if (ForwardMask & LaneBit)
+			{
+				Direction = EALSMovementDirection::Forward;
+			}
+			else if (RightMask & LaneBit)
+			{
+				Direction = EALSMovementDirection::Right;
+			}
+			else if (LeftMask & LaneBit)
+			{
+				Direction = EALSMovementDirection::Left;
+			}
+			else
+			{
+				Direction = EALSMovementDirection::Backward;
+			}
+		}
 	}
+}
+
+void UALSMathLibrary::CalculateVelocityBlends(TArrayView<const float> VelocitiesX, TArrayView<const float> VelocitiesY,
+                                              TArrayView<const float> VelocitiesZ, TArrayView<const float> ActorYaws,
+                                              TArrayView<float> OutF, TArrayView<float> OutB, TArrayView<float> OutL,
+                                              TArrayView<float> OutR)
+{
+	const int32 Num = VelocitiesX.Num();
+	check(VelocitiesY.Num() == Num && VelocitiesZ.Num() == Num && ActorYaws.Num() == Num);
+	check(OutF.Num() == Num && OutB.Num() == Num && OutL.Num() == Num && OutR.Num() == Num);
 
-	if (AngleInRange(Angle, BLThreshold, FLThreshold, Buffer,
-	                 Current != EALSMovementDirection::Right && Current != EALSMovementDirection::Left))
+	for (int32 Index = 0; Index < Num; Index += ALSBatch::NumLanes)
 	{
-		return EALSMovementDirection::Left;
+		const int32 Count = FMath::Min(ALSBatch::NumLanes, Num - Index);
+		VectorRegister4Float X = ALSBatch::Load(VelocitiesX, Index, Count);
+		VectorRegister4Float Y = ALSBatch::Load(VelocitiesY, Index, Count);
+		const VectorRegister4Float Z = ALSBatch::Load(VelocitiesZ, Index, Count);
+		ALSBatch::UnrotateByYaw(ALSBatch::Load(ActorYaws, Index, Count), X, Y);
+
+		// Normalizing the direction before dividing by the sum of its components cancels out, so only the
+		// GetSafeNormal threshold is kept. Velocities below it produce a zero blend.
+		const VectorRegister4Float SizeSquared = VectorMultiplyAdd(X, X, VectorMultiplyAdd(Y, Y, VectorMultiply(Z, Z)));
+		const VectorRegister4Float bMoving = VectorCompareGE(SizeSquared, VectorSetFloat1(0.1f));
+		const VectorRegister4Float Sum = VectorMax(VectorAdd(VectorAdd(VectorAbs(X), VectorAbs(Y)), VectorAbs(Z)),
+		                                           VectorSetFloat1(UE_SMALL_NUMBER));
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float RelativeX = VectorSelect(bMoving, VectorDivide(X, Sum), Zero);
+		const VectorRegister4Float RelativeY = VectorSelect(bMoving, VectorDivide(Y, Sum), Zero);
+
+		ALSBatch::Store(ALSBatch::Clamp(RelativeX, 0.0f, 1.0f), OutF, Index, Count);
+		ALSBatch::Store(ALSBatch::Clamp(VectorNegate(RelativeX), 0.0f, 1.0f), OutB, Index, Count);
+		ALSBatch::Store(ALSBatch::Clamp(VectorNegate(RelativeY), 0.0f, 1.0f), OutL, Index, Count);
+		ALSBatch::Store(ALSBatch::Clamp(RelativeY, 0.0f, 1.0f), OutR, Index, Count);
 	}
+}
 
-	return EALSMovementDirection::Backward;
+void UALSMathLibrary::InterpLeanAmounts(TArrayView<const float> AccelerationsX, TArrayView<const float> AccelerationsY,
+                                        TArrayView<const float> ActorYaws, TArrayView<const float> MaxAccelerations,
+                                        TArrayView<float> InOutLR, TArrayView<float> InOutFB, float DeltaTime,
+                                        float InterpSpeed)
+{
+	const int32 Num = AccelerationsX.Num();
+	check(AccelerationsY.Num() == Num && ActorYaws.Num() == Num && MaxAccelerations.Num() == Num);
+	check(InOutLR.Num() == Num && InOutFB.Num() == Num);
+
+	for (int32 Index = 0; Index < Num; Index += ALSBatch::NumLanes)
+	{
+		const int32 Count = FMath::Min(ALSBatch::NumLanes, Num - Index);
+		VectorRegister4Float X = ALSBatch::Load(AccelerationsX, Index, Count);
+		VectorRegister4Float Y = ALSBatch::Load(AccelerationsY, Index, Count);
+		ALSBatch::UnrotateByYaw(ALSBatch::Load(ActorYaws, Index, Count), X, Y);
+
+		// Clamp the acceleration to the max size and normalize it to (-1, 1) range. Lean amounts use the planar
+		// components only, so the vertical acceleration doesn't affect them.
+		const VectorRegister4Float MaxAcc = VectorMax(ALSBatch::Load(MaxAccelerations, Index, Count),
+		                                              VectorSetFloat1(UE_SMALL_NUMBER));
+		const VectorRegister4Float Size = VectorSqrt(VectorMultiplyAdd(X, X, VectorMultiply(Y, Y)));
+		const VectorRegister4Float Scale = VectorDivide(VectorSetFloat1(1.0f), VectorMax(Size, MaxAcc));
+		X = VectorMultiply(X, Scale);
+		Y = VectorMultiply(Y, Scale);
+
+		const VectorRegister4Float LR = ALSBatch::Load(InOutLR, Index, Count);
+		const VectorRegister4Float FB = ALSBatch::Load(InOutFB, Index, Count);
+		ALSBatch::Store(ALSBatch::InterpTo(LR, Y, DeltaTime, InterpSpeed), InOutLR, Index, Count);
+		ALSBatch::Store(ALSBatch::InterpTo(FB, X, DeltaTime, InterpSpeed), InOutFB, Index, Count);
+	}
 }
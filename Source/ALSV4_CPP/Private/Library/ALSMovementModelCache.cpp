@@ -0,0 +1,117 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Library/ALSMovementModelCache.h"
+
+namespace ALSMovementModelCache
+{
+	using FKey = TPair<TWeakObjectPtr<const UDataTable>, FName>;
+
+	/* Cache is only touched from the game thread, like the BeginPlay calls resolving movement models */
+	static TMap<FKey, TWeakPtr<const FALSMovementModel>> Models;
+
+	/* Data tables we already listen to for changes */
+	static TMap<TWeakObjectPtr<const UDataTable>, FDelegateHandle> WatchedTables;
+
+	static FALSMovementModelCache::FOnMovementModelsInvalidated InvalidatedDelegate;
+}
+
+FALSMovementModel::FALSMovementModel(const FALSMovementStateSettings& InSettings)
+	: Settings(InSettings)
+{
+	SettingsByIndex[GetSettingsIndex(EALSRotationMode::VelocityDirection, EALSStance::Standing)] =
+		&Settings.VelocityDirection.Standing;
+	SettingsByIndex[GetSettingsIndex(EALSRotationMode::VelocityDirection, EALSStance::Crouching)] =
+		&Settings.VelocityDirection.Crouching;
+	SettingsByIndex[GetSettingsIndex(EALSRotationMode::LookingDirection, EALSStance::Standing)] =
+		&Settings.LookingDirection.Standing;
+	SettingsByIndex[GetSettingsIndex(EALSRotationMode::LookingDirection, EALSStance::Crouching)] =
+		&Settings.LookingDirection.Crouching;
+	SettingsByIndex[GetSettingsIndex(EALSRotationMode::Aiming, EALSStance::Standing)] =
+		&Settings.Aiming.Standing;
+	SettingsByIndex[GetSettingsIndex(EALSRotationMode::Aiming, EALSStance::Crouching)] =
+		&Settings.Aiming.Crouching;
+}
+
+int32 FALSMovementModel::GetSettingsIndex(EALSRotationMode RotationMode, EALSStance Stance)
+{
+	const int32 ModeIndex = static_cast<int32>(RotationMode);
+	const int32 StanceIndex = static_cast<int32>(Stance);
+	if (ModeIndex > static_cast<int32>(EALSRotationMode::Aiming) || StanceIndex > static_cast<int32>(EALSStance::Crouching))
+	{
+		// Default to velocity dir standing
+		return 0;
+	}
+	return ModeIndex * 2 + StanceIndex;
+}
+
+TSharedPtr<const FALSMovementModel> FALSMovementModelCache::Get(const FDataTableRowHandle& Handle)
+{
+	check(IsInGameThread());
+
+	using namespace ALSMovementModelCache;
+
+	if (!Handle.DataTable)
+	{
+		return nullptr;
+	}
+
+	const FKey Key(Handle.DataTable.Get(), Handle.RowName);
+	if (TWeakPtr<const FALSMovementModel>* Cached = Models.Find(Key))
+	{
+		if (TSharedPtr<const FALSMovementModel> Model = Cached->Pin())
+		{
+			return Model;
+		}
+	}
+
+	const FALSMovementStateSettings* Row =
+		Handle.DataTable->FindRow<FALSMovementStateSettings>(Handle.RowName, TEXT("ALS Movement Model"));
+	if (!Row)
+	{
+		return nullptr;
+	}
+
+	// Drop entries released by all their characters before adding a new one
+	for (auto It = Models.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TSharedPtr<const FALSMovementModel> Model = MakeShared<FALSMovementModel>(*Row);
+	Models.Add(Key, Model);
+
+	if (!WatchedTables.Contains(Key.Key))
+	{
+		UDataTable* DataTable = const_cast<UDataTable*>(Handle.DataTable.Get());
+		WatchedTables.Add(Key.Key, DataTable->OnDataTableChanged().AddStatic(
+			                  &FALSMovementModelCache::OnDataTableChanged, Key.Key));
+	}
+
+	return Model;
+}
+
+FALSMovementModelCache::FOnMovementModelsInvalidated& FALSMovementModelCache::OnMovementModelsInvalidated()
+{
+	return ALSMovementModelCache::InvalidatedDelegate;
+}
+
+void FALSMovementModelCache::OnDataTableChanged(TWeakObjectPtr<const UDataTable> DataTable)
+{
+	using namespace ALSMovementModelCache;
+
+	for (auto It = Models.CreateIterator(); It; ++It)
+	{
+		if (It->Key.Key == DataTable || !It->Key.Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Characters still hold the old model until they resolve the row again
+	InvalidatedDelegate.Broadcast(DataTable.Get());
+}
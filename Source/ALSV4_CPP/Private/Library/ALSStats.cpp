@@ -0,0 +1,58 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Library/ALSStats.h"
+
+DEFINE_STAT(STAT_ALS_FootIKTraces);
+DEFINE_STAT(STAT_ALS_LandPredictionTraces);
+DEFINE_STAT(STAT_ALS_CameraTraces);
+DEFINE_STAT(STAT_ALS_MantleTraces);
+DEFINE_STAT(STAT_ALS_RagdollTraces);
+DEFINE_STAT(STAT_ALS_FootstepTraces);
+DEFINE_STAT(STAT_ALS_DeferredTraces);
+DEFINE_STAT(STAT_ALS_ReusedTraces);
+DEFINE_STAT(STAT_ALS_GroundProbes);
+DEFINE_STAT(STAT_ALS_SharedGroundProbes);
+
+DEFINE_STAT(STAT_ALS_FullRagdolls);
+DEFINE_STAT(STAT_ALS_ReducedRagdolls);
+DEFINE_STAT(STAT_ALS_SimpleRagdolls);
+DEFINE_STAT(STAT_ALS_SettledRagdolls);
+
+DEFINE_STAT(STAT_ALS_HighSignificanceAI);
+DEFINE_STAT(STAT_ALS_MediumSignificanceAI);
+DEFINE_STAT(STAT_ALS_LowSignificanceAI);
+
+DEFINE_STAT(STAT_ALS_CrowdAgents);
+DEFINE_STAT(STAT_ALS_HydratedCrowdAgents);
+
+CSV_DEFINE_CATEGORY_MODULE(ALSV4_CPP_API, ALS, true);
+
+#if ALS_STAGE_TIMINGS
+namespace ALSStageTimings
+{
+	std::atomic<bool> bEnabled(false);
+
+	/* Anim updates can run on worker threads*/
+	static std::atomic<uint64> StageCycles[static_cast<int32>(EALSStage::MAX)];
+
+	void AddCycles(EALSStage Stage, uint64 Cycles)
+	{
+		StageCycles[static_cast<int32>(Stage)].fetch_add(Cycles, std::memory_order_relaxed);
+	}
+
+	double GetSeconds(EALSStage Stage)
+	{
+		return FPlatformTime::ToSeconds64(StageCycles[static_cast<int32>(Stage)].load(std::memory_order_relaxed));
+	}
+
+	void Reset()
+	{
+		for (std::atomic<uint64>& Cycles : StageCycles)
+		{
+			Cycles.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+#endif
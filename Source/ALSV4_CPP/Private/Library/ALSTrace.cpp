@@ -0,0 +1,205 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Library/ALSTrace.h"
+
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSStats.h"
+
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(ALSChannel)
+
+UE_TRACE_EVENT_BEGIN(ALS, StateTransition)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, ActorId)
+	UE_TRACE_EVENT_FIELD(uint8, Kind)
+	UE_TRACE_EVENT_FIELD(uint8, OldValue)
+	UE_TRACE_EVENT_FIELD(uint8, NewValue)
+UE_TRACE_EVENT_END()
+
+namespace ALSTrace
+{
+	bool bRecordTransitions = false;
+
+	static FAutoConsoleVariableRef CVarRecordTransitions(
+		TEXT("ALS.Trace.RecordTransitions"), bRecordTransitions,
+		TEXT("Record ALS state transitions into a ring buffer that can be written out with ALS.Trace.DumpTransitions."));
+
+	static constexpr int32 MaxRecordedTransitions = 16384;
+
+	struct FTransitionRecord
+	{
+		uint64 Frame = 0;
+		double Time = 0.0;
+		uint32 ActorId = 0;
+		FName ActorName;
+		EALSTraceTransition Kind = EALSTraceTransition::MovementState;
+		uint8 OldValue = 0;
+		uint8 NewValue = 0;
+	};
+
+	/* Transitions only come from the game thread, so the ring buffer is not locked */
+	static TArray<FTransitionRecord> RecordedTransitions;
+	static int32 NextRecordIndex = 0;
+
+	static const TCHAR* GetKindName(EALSTraceTransition Kind)
+	{
+		switch (Kind)
+		{
+		case EALSTraceTransition::MovementState:
+			return TEXT("MovementState");
+		case EALSTraceTransition::Gait:
+			return TEXT("Gait");
+		case EALSTraceTransition::Stance:
+			return TEXT("Stance");
+		case EALSTraceTransition::RotationMode:
+			return TEXT("RotationMode");
+		case EALSTraceTransition::OverlayState:
+			return TEXT("OverlayState");
+		case EALSTraceTransition::MantleStart:
+			return TEXT("MantleStart");
+		case EALSTraceTransition::MantleEnd:
+			return TEXT("MantleEnd");
+		case EALSTraceTransition::RagdollStart:
+			return TEXT("RagdollStart");
+		case EALSTraceTransition::RagdollEnd:
+			return TEXT("RagdollEnd");
+		default:
+			return TEXT("Unknown");
+		}
+	}
+
+	static FString GetValueName(EALSTraceTransition Kind, uint8 Value)
+	{
+		const UEnum* Enum = nullptr;
+		switch (Kind)
+		{
+		case EALSTraceTransition::MovementState:
+			Enum = StaticEnum<EALSMovementState>();
+			break;
+		case EALSTraceTransition::Gait:
+			Enum = StaticEnum<EALSGait>();
+			break;
+		case EALSTraceTransition::Stance:
+			Enum = StaticEnum<EALSStance>();
+			break;
+		case EALSTraceTransition::RotationMode:
+			Enum = StaticEnum<EALSRotationMode>();
+			break;
+		case EALSTraceTransition::OverlayState:
+			Enum = StaticEnum<EALSOverlayState>();
+			break;
+		case EALSTraceTransition::MantleStart:
+			Enum = StaticEnum<EALSMantleType>();
+			break;
+		case EALSTraceTransition::RagdollStart:
+		case EALSTraceTransition::RagdollEnd:
+			Enum = StaticEnum<EALSRagdollLOD>();
+			break;
+		default:
+			break;
+		}
+
+		return Enum ? Enum->GetNameStringByValue(Value) : FString::FromInt(Value);
+	}
+
+	void OutputStateTransition(const AActor* Actor, EALSTraceTransition Kind, uint8 OldValue, uint8 NewValue)
+	{
+		const uint32 ActorId = Actor ? Actor->GetUniqueID() : 0;
+
+		if (UE_TRACE_CHANNELEXPR_IS_ENABLED(ALSChannel))
+		{
+			UE_TRACE_LOG(ALS, StateTransition, ALSChannel)
+				<< StateTransition.Cycle(FPlatformTime::Cycles64())
+				<< StateTransition.ActorId(ActorId)
+				<< StateTransition.Kind(static_cast<uint8>(Kind))
+				<< StateTransition.OldValue(OldValue)
+				<< StateTransition.NewValue(NewValue);
+
+			// Bookmarks are what the Timing view draws on the frame timeline without a custom analyzer
+			TRACE_BOOKMARK(TEXT("ALS %u %s: %s -> %s"), ActorId, GetKindName(Kind),
+			               *GetValueName(Kind, OldValue), *GetValueName(Kind, NewValue));
+		}
+
+#if CSV_PROFILER
+		if (FCsvProfiler::Get()->IsCapturing())
+		{
+			CSV_CUSTOM_STAT(ALS, StateTransitions, 1, ECsvCustomStatOp::Accumulate);
+			CSV_EVENT(ALS, TEXT("%u %s: %s -> %s"), ActorId, GetKindName(Kind),
+			          *GetValueName(Kind, OldValue), *GetValueName(Kind, NewValue));
+		}
+#endif
+
+		if (bRecordTransitions)
+		{
+			FTransitionRecord Record;
+			Record.Frame = GFrameCounter;
+			Record.Time = FPlatformTime::Seconds();
+			Record.ActorId = ActorId;
+			Record.ActorName = Actor ? Actor->GetFName() : NAME_None;
+			Record.Kind = Kind;
+			Record.OldValue = OldValue;
+			Record.NewValue = NewValue;
+
+			if (RecordedTransitions.Num() < MaxRecordedTransitions)
+			{
+				RecordedTransitions.Add(Record);
+			}
+			else
+			{
+				RecordedTransitions[NextRecordIndex] = Record;
+			}
+			NextRecordIndex = (NextRecordIndex + 1) % MaxRecordedTransitions;
+		}
+	}
+
+	FString DumpTransitionsToCsv()
+	{
+		if (RecordedTransitions.Num() == 0)
+		{
+			return FString();
+		}
+
+		FString Csv = TEXT("Frame,Time,ActorId,Actor,Transition,Old,New\n");
+
+		// Oldest record sits at NextRecordIndex once the ring buffer has wrapped
+		const int32 Num = RecordedTransitions.Num();
+		const int32 First = Num < MaxRecordedTransitions ? 0 : NextRecordIndex;
+		for (int32 Offset = 0; Offset < Num; ++Offset)
+		{
+			const FTransitionRecord& Record = RecordedTransitions[(First + Offset) % Num];
+			Csv += FString::Printf(TEXT("%llu,%.6f,%u,%s,%s,%s,%s\n"), Record.Frame, Record.Time, Record.ActorId,
+			                       *Record.ActorName.ToString(), GetKindName(Record.Kind),
+			                       *GetValueName(Record.Kind, Record.OldValue),
+			                       *GetValueName(Record.Kind, Record.NewValue));
+		}
+
+		const FString FileName = FPaths::ProfilingDir() / TEXT("ALS") /
+			FString::Printf(TEXT("StateTransitions-%s.csv"), *FDateTime::Now().ToString());
+		if (!FFileHelper::SaveStringToFile(Csv, *FileName))
+		{
+			return FString();
+		}
+
+		RecordedTransitions.Reset();
+		NextRecordIndex = 0;
+		return FileName;
+	}
+
+	static FAutoConsoleCommand CmdDumpTransitions(
+		TEXT("ALS.Trace.DumpTransitions"),
+		TEXT("Write the transitions recorded with ALS.Trace.RecordTransitions to Saved/Profiling/ALS as CSV."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			const FString FileName = DumpTransitionsToCsv();
+			UE_LOG(LogTemp, Log, TEXT("ALS state transitions: %s"),
+			       FileName.IsEmpty() ? TEXT("nothing written") : *FileName);
+		}));
+}
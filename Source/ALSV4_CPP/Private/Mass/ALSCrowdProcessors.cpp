@@ -0,0 +1,255 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Mass/ALSCrowdProcessors.h"
+
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+#include "MassExecutionContext.h"
+#include "Library/ALSLocomotionCore.h"
+#include "Library/ALSMathLibrary.h"
+#include "Library/ALSMovementModelCache.h"
+#include "Library/ALSStats.h"
+#include "Mass/ALSCrowdFragments.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Gait"), STAT_ALS_CrowdGait, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Crowd Rotation"), STAT_ALS_CrowdRotation, STATGROUP_ALS);
+
+namespace ALSCrowd
+{
+	/* Acceleration, braking deceleration and ground friction used without a movement curve*/
+	static const FVector DefaultMovementCurveValue(2048.0f, 2048.0f, 8.0f);
+
+	static float GetMappedSpeed(const FALSMovementSettings& Settings, float Speed)
+	{
+		return ALSLocomotionCore::GetMappedSpeed(Speed, Settings.WalkSpeed, Settings.RunSpeed, Settings.SprintSpeed);
+	}
+
+	/* Per chunk values handed to the batch kernels, one element per entity*/
+	using FChunkValues = TArray<float, TInlineAllocator<256>>;
+}
+
+UALSCrowdGaitProcessor::UALSCrowdGaitProcessor()
+{
+	// Executed by UALSCrowdSubsystem, doesn't depend on the Mass simulation phases
+	bAutoRegisterWithProcessingPhases = false;
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+}
+
+void UALSCrowdGaitProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FALSCrowdTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FALSCrowdMovementFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FALSCrowdStateFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FALSCrowdAgentFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddTagRequirement<FALSCrowdHydratedTag>(EMassFragmentPresence::None);
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UALSCrowdGaitProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CrowdGait);
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& ChunkContext)
+	{
+		const TArrayView<FALSCrowdTransformFragment> Transforms =
+			ChunkContext.GetMutableFragmentView<FALSCrowdTransformFragment>();
+		const TArrayView<FALSCrowdMovementFragment> Movements =
+			ChunkContext.GetMutableFragmentView<FALSCrowdMovementFragment>();
+		const TArrayView<FALSCrowdStateFragment> States = ChunkContext.GetMutableFragmentView<FALSCrowdStateFragment>();
+		const TConstArrayView<FALSCrowdAgentFragment> Agents =
+			ChunkContext.GetFragmentView<FALSCrowdAgentFragment>();
+		const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+		const int32 NumEntities = ChunkContext.GetNumEntities();
+
+		// Input to aim yaw deltas of the whole chunk at once, only looking direction agents use them
+		ALSCrowd::FChunkValues InputYaws;
+		ALSCrowd::FChunkValues AimYaws;
+		ALSCrowd::FChunkValues InputAimYawDeltas;
+		InputYaws.SetNumUninitialized(NumEntities);
+		AimYaws.SetNumUninitialized(NumEntities);
+		InputAimYawDeltas.SetNumUninitialized(NumEntities);
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			InputYaws[Index] = Movements[Index].MovementInput.Rotation().Yaw;
+			AimYaws[Index] = Movements[Index].AimYaw;
+		}
+		UALSMathLibrary::CalculateYawDeltas(InputYaws, AimYaws, InputAimYawDeltas);
+
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			FALSCrowdMovementFragment& Movement = Movements[Index];
+			FALSCrowdStateFragment& State = States[Index];
+			if (!Agents[Index].MovementModel || State.MovementState != EALSMovementState::Grounded)
+			{
+				continue;
+			}
+
+			const FALSMovementSettings& Settings = Agents[Index].MovementModel->GetSettings(
+				FALSMovementModel::GetSettingsIndex(State.RotationMode, State.Stance));
+
+			const FVector Input = Movement.MovementInput.GetClampedToMaxSize2D(1.0f);
+			const float InputAmount = Input.Size2D();
+			const bool bHasMovementInput = InputAmount > 0.0f;
+			const float InputAimYawDelta = State.RotationMode == EALSRotationMode::LookingDirection
+				                               ? InputAimYawDeltas[Index]
+				                               : 0.0f;
+
+			// Same allowed and actual gait rules as the character
+			const bool bCanSprint = State.DesiredGait == EALSGait::Sprinting &&
+				ALSLocomotionCore::CanSprint(bHasMovementInput, InputAmount,
+				                             static_cast<ALSLocomotionCore::ERotationMode>(State.RotationMode),
+				                             InputAimYawDelta);
+			const ALSLocomotionCore::EGait AllowedGait = ALSLocomotionCore::GetAllowedGait(
+				static_cast<ALSLocomotionCore::EStance>(State.Stance),
+				static_cast<ALSLocomotionCore::ERotationMode>(State.RotationMode),
+				static_cast<ALSLocomotionCore::EGait>(State.DesiredGait), bCanSprint);
+			State.Gait = static_cast<EALSGait>(ALSLocomotionCore::GetActualGait(
+				AllowedGait, Movement.Speed, Settings.WalkSpeed, Settings.RunSpeed));
+
+			// Accelerate towards the allowed gait speed with the rates of the movement curve
+			const FVector CurveValue = Settings.MovementCurve
+				                           ? Settings.MovementCurve->GetVectorValue(
+					                           ALSCrowd::GetMappedSpeed(Settings, Movement.Speed))
+				                           : ALSCrowd::DefaultMovementCurveValue;
+			const FVector TargetVelocity = Input * Settings.GetSpeedForGait(static_cast<EALSGait>(AllowedGait));
+			Movement.Velocity = FMath::VInterpConstantTo(Movement.Velocity, TargetVelocity, DeltaTime,
+			                                             bHasMovementInput ? CurveValue.X : CurveValue.Y);
+			Movement.Velocity.Z = 0.0f;
+			Movement.Speed = Movement.Velocity.Size2D();
+			if (Movement.Speed > 1.0f)
+			{
+				Movement.LastVelocityYaw = Movement.Velocity.Rotation().Yaw;
+			}
+
+			Transforms[Index].Location += Movement.Velocity * DeltaTime;
+		}
+	});
+}
+
+UALSCrowdRotationProcessor::UALSCrowdRotationProcessor()
+{
+	bAutoRegisterWithProcessingPhases = false;
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ExecutionOrder.ExecuteAfter.Add(UALSCrowdGaitProcessor::StaticClass()->GetFName());
+}
+
+void UALSCrowdRotationProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FALSCrowdTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FALSCrowdMovementFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FALSCrowdStateFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FALSCrowdAgentFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddTagRequirement<FALSCrowdHydratedTag>(EMassFragmentPresence::None);
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UALSCrowdRotationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CrowdRotation);
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& ChunkContext)
+	{
+		const TArrayView<FALSCrowdTransformFragment> Transforms =
+			ChunkContext.GetMutableFragmentView<FALSCrowdTransformFragment>();
+		const TConstArrayView<FALSCrowdMovementFragment> Movements =
+			ChunkContext.GetFragmentView<FALSCrowdMovementFragment>();
+		const TConstArrayView<FALSCrowdStateFragment> States = ChunkContext.GetFragmentView<FALSCrowdStateFragment>();
+		const TConstArrayView<FALSCrowdAgentFragment> Agents =
+			ChunkContext.GetFragmentView<FALSCrowdAgentFragment>();
+		const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+		const int32 NumEntities = ChunkContext.GetNumEntities();
+
+		// Goal yaws and interp speeds of the rotating agents. Others keep zero speeds and aren't written back
+		ALSCrowd::FChunkValues GoalYaws;
+		ALSCrowd::FChunkValues TargetInterpSpeeds;
+		ALSCrowd::FChunkValues ActorInterpSpeeds;
+		GoalYaws.SetNumZeroed(NumEntities);
+		TargetInterpSpeeds.SetNumZeroed(NumEntities);
+		ActorInterpSpeeds.SetNumZeroed(NumEntities);
+		TBitArray<TInlineAllocator<8>> Rotating(false, NumEntities);
+
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			const FALSCrowdMovementFragment& Movement = Movements[Index];
+			const FALSCrowdStateFragment& State = States[Index];
+			const bool bHasMovementInput = !Movement.MovementInput.IsNearlyZero();
+			if (!Agents[Index].MovementModel || State.MovementState != EALSMovementState::Grounded ||
+				!((Movement.Speed > 1.0f && bHasMovementInput) || Movement.Speed > 150.0f))
+			{
+				continue;
+			}
+
+			const FALSMovementSettings& Settings = Agents[Index].MovementModel->GetSettings(
+				FALSMovementModel::GetSettingsIndex(State.RotationMode, State.Stance));
+			const float CurveValue = Settings.RotationRateCurve
+				                         ? Settings.RotationRateCurve->GetFloatValue(
+					                         ALSCrowd::GetMappedSpeed(Settings, Movement.Speed))
+				                         : 10.0f;
+			// Agents have no camera, so the aim yaw rate doesn't speed up the rotation
+			const float GroundedRotationRate = ALSLocomotionCore::CalculateGroundedRotationRate(CurveValue, 0.0f);
+
+			Rotating[Index] = true;
+			ActorInterpSpeeds[Index] = GroundedRotationRate;
+			if (State.RotationMode == EALSRotationMode::VelocityDirection)
+			{
+				GoalYaws[Index] = Movement.LastVelocityYaw;
+				TargetInterpSpeeds[Index] = 800.0f;
+			}
+			else if (State.RotationMode == EALSRotationMode::LookingDirection)
+			{
+				GoalYaws[Index] = State.Gait == EALSGait::Sprinting ? Movement.LastVelocityYaw : Movement.AimYaw;
+				TargetInterpSpeeds[Index] = 500.0f;
+			}
+			else
+			{
+				GoalYaws[Index] = Movement.AimYaw;
+				TargetInterpSpeeds[Index] = 1000.0f;
+				ActorInterpSpeeds[Index] = 20.0f;
+			}
+		}
+
+		// Same as AALSBaseCharacter::SmoothCharacterRotation: the target yaw moves towards the goal at a constant
+		// rate (RInterpConstantTo), then the actor yaw eases towards the target yaw (RInterpTo).
+		ALSCrowd::FChunkValues TargetYaws;
+		ALSCrowd::FChunkValues Deltas;
+		TargetYaws.SetNumUninitialized(NumEntities);
+		Deltas.SetNumUninitialized(NumEntities);
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			TargetYaws[Index] = Transforms[Index].TargetYaw;
+		}
+		UALSMathLibrary::CalculateYawDeltas(GoalYaws, TargetYaws, Deltas);
+
+		ALSCrowd::FChunkValues ActorYaws;
+		ActorYaws.SetNumUninitialized(NumEntities);
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			if (Rotating[Index])
+			{
+				const float MaxStep = TargetInterpSpeeds[Index] * DeltaTime;
+				TargetYaws[Index] = FRotator::NormalizeAxis(
+					TargetYaws[Index] + FMath::Clamp(Deltas[Index], -MaxStep, MaxStep));
+			}
+			ActorYaws[Index] = Transforms[Index].Yaw;
+		}
+		UALSMathLibrary::CalculateYawDeltas(TargetYaws, ActorYaws, Deltas);
+
+		for (int32 Index = 0; Index < NumEntities; ++Index)
+		{
+			if (!Rotating[Index])
+			{
+				continue;
+			}
+
+			FALSCrowdTransformFragment& Transform = Transforms[Index];
+			Transform.TargetYaw = TargetYaws[Index];
+			Transform.Yaw = FMath::IsNearlyZero(Deltas[Index])
+				                ? TargetYaws[Index]
+				                : FRotator::NormalizeAxis(
+					                ActorYaws[Index] + Deltas[Index] * FMath::Clamp(
+						                DeltaTime * ActorInterpSpeeds[Index], 0.0f, 1.0f));
+		}
+	});
+}
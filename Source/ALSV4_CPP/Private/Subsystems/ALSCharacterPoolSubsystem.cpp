@@ -0,0 +1,178 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Subsystems/ALSCharacterPoolSubsystem.h"
+
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
+
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Pool Spawn"), STAT_ALS_CharacterPoolSpawn, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Character Pool Reuse"), STAT_ALS_CharacterPoolReuse, STATGROUP_ALS);
+
+
+void UALSCharacterPoolSubsystem::Deinitialize()
+{
+	Pools.Reset();
+
+	Super::Deinitialize();
+}
+
+AALSBaseCharacter* UALSCharacterPoolSubsystem::AcquireCharacter(TSubclassOf<AALSBaseCharacter> CharacterClass,
+                                                                const FTransform& Transform)
+{
+	if (!CharacterClass)
+	{
+		return nullptr;
+	}
+
+	AALSBaseCharacter* Character = nullptr;
+	if (FALSPooledCharacters* Pool = Pools.Find(CharacterClass))
+	{
+		while (!Character && Pool->Characters.Num() > 0)
+		{
+			Character = Pool->Characters.Pop(false);
+			if (!IsValid(Character))
+			{
+				Character = nullptr;
+			}
+		}
+	}
+
+	if (!Character)
+	{
+		return SpawnCharacter(CharacterClass, Transform);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CharacterPoolReuse);
+	const double StartTime = FPlatformTime::Seconds();
+
+	Character->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	SetCharacterActive(Character, true);
+	Character->ResetALSState();
+
+	if (!Character->GetController())
+	{
+		Character->SpawnDefaultController();
+	}
+	else if (AAIController* AIController = Cast<AAIController>(Character->GetController()))
+	{
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
+
+	TotalReuseSeconds += FPlatformTime::Seconds() - StartTime;
+	++Stats.Reused;
+	return Character;
+}
+
+void UALSCharacterPoolSubsystem::ReleaseCharacter(AALSBaseCharacter* Character)
+{
+	if (!IsValid(Character))
+	{
+		return;
+	}
+
+	FALSPooledCharacters& Pool = Pools.FindOrAdd(Character->GetClass());
+	if (Pool.Characters.Num() >= MaxPooledPerClass)
+	{
+		Character->Destroy();
+		return;
+	}
+
+	if (AAIController* AIController = Cast<AAIController>(Character->GetController()))
+	{
+		AIController->StopMovement();
+		if (UBrainComponent* Brain = AIController->GetBrainComponent())
+		{
+			Brain->StopLogic(TEXT("Released to ALS character pool"));
+		}
+	}
+
+	// Hidden ragdolls would keep simulating and stay registered for ragdoll LOD
+	if (Character->GetMovementState() == EALSMovementState::Ragdoll)
+	{
+		Character->ResetALSState();
+	}
+
+	SetCharacterActive(Character, false);
+	Pool.Characters.AddUnique(Character);
+	++Stats.Released;
+}
+
+void UALSCharacterPoolSubsystem::Prewarm(TSubclassOf<AALSBaseCharacter> CharacterClass, int32 Count)
+{
+	if (!CharacterClass)
+	{
+		return;
+	}
+
+	for (int32 Index = GetNumPooled(CharacterClass); Index < Count; ++Index)
+	{
+		if (AALSBaseCharacter* Character = SpawnCharacter(CharacterClass, FTransform::Identity))
+		{
+			ReleaseCharacter(Character);
+		}
+	}
+}
+
+int32 UALSCharacterPoolSubsystem::GetNumPooled(TSubclassOf<AALSBaseCharacter> CharacterClass) const
+{
+	const FALSPooledCharacters* Pool = Pools.Find(CharacterClass);
+	return Pool ? Pool->Characters.Num() : 0;
+}
+
+FALSCharacterPoolStats UALSCharacterPoolSubsystem::GetPoolStats() const
+{
+	FALSCharacterPoolStats Result = Stats;
+	Result.AverageSpawnMs = Stats.Spawned > 0 ? static_cast<float>(TotalSpawnSeconds * 1000.0 / Stats.Spawned) : 0.0f;
+	Result.AverageReuseMs = Stats.Reused > 0 ? static_cast<float>(TotalReuseSeconds * 1000.0 / Stats.Reused) : 0.0f;
+	return Result;
+}
+
+AALSBaseCharacter* UALSCharacterPoolSubsystem::SpawnCharacter(UClass* CharacterClass, const FTransform& Transform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CharacterPoolSpawn);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	AALSBaseCharacter* Character = GetWorld()->SpawnActor<AALSBaseCharacter>(CharacterClass, Transform, SpawnParameters);
+	if (Character && !Character->GetController())
+	{
+		Character->SpawnDefaultController();
+	}
+
+	TotalSpawnSeconds += FPlatformTime::Seconds() - StartTime;
+	++Stats.Spawned;
+	return Character;
+}
+
+void UALSCharacterPoolSubsystem::SetCharacterActive(AALSBaseCharacter* Character, bool bActive)
+{
+	Character->SetActorHiddenInGame(!bActive);
+	Character->SetActorEnableCollision(bActive);
+	Character->SetActorTickEnabled(bActive);
+
+	// Restore ticking only for components that tick by default, components that stopped themselves stay stopped
+	for (UActorComponent* Component : Character->GetComponents())
+	{
+		if (Component && Component->PrimaryComponentTick.bCanEverTick)
+		{
+			Component->SetComponentTickEnabled(bActive && Component->PrimaryComponentTick.bStartWithTickEnabled);
+		}
+	}
+
+	if (!bActive)
+	{
+		Character->GetCharacterMovement()->StopMovementImmediately();
+		Character->GetCharacterMovement()->DisableMovement();
+	}
+}
@@ -0,0 +1,473 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Subsystems/ALSCrowdSubsystem.h"
+
+#include "MassEntitySubsystem.h"
+#include "MassExecutor.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Library/ALSMovementModelCache.h"
+#include "Library/ALSStats.h"
+#include "Mass/ALSCrowdFragments.h"
+#include "Mass/ALSCrowdProcessors.h"
+#include "Subsystems/ALSCharacterPoolSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Simulate"), STAT_ALS_CrowdSimulate, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Crowd Hydration"), STAT_ALS_CrowdHydration, STATGROUP_ALS);
+
+
+void UALSCrowdSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency<UMassEntitySubsystem>();
+
+	AgentArchetype = GetEntityManager().CreateArchetype({
+		FALSCrowdTransformFragment::StaticStruct(),
+		FALSCrowdMovementFragment::StaticStruct(),
+		FALSCrowdStateFragment::StaticStruct(),
+		FALSCrowdAgentFragment::StaticStruct()
+	}, TEXT("ALSCrowdAgent"));
+
+	Pipeline.AppendProcessor(*NewObject<UALSCrowdGaitProcessor>(this));
+	Pipeline.AppendProcessor(*NewObject<UALSCrowdRotationProcessor>(this));
+	Pipeline.Initialize(*this);
+}
+
+void UALSCrowdSubsystem::Deinitialize()
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+	for (const FMassEntityHandle& Agent : Agents)
+	{
+		if (EntityManager.IsEntityValid(Agent))
+		{
+			EntityManager.DestroyEntity(Agent);
+		}
+	}
+	SET_DWORD_STAT(STAT_ALS_CrowdAgents, 0);
+	SET_DWORD_STAT(STAT_ALS_HydratedCrowdAgents, 0);
+	Agents.Reset();
+	HydratedAgents.Reset();
+
+	Super::Deinitialize();
+}
+
+void UALSCrowdSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bAutoSimulate && Agents.Num() > 0)
+	{
+		Simulate(DeltaTime);
+	}
+}
+
+TStatId UALSCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSCrowdSubsystem, STATGROUP_Tickables);
+}
+
+FMassEntityManager& UALSCrowdSubsystem::GetEntityManager() const
+{
+	UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+	check(EntitySubsystem);
+	return EntitySubsystem->GetMutableEntityManager();
+}
+
+FMassEntityHandle UALSCrowdSubsystem::SpawnAgent(TSubclassOf<AALSBaseCharacter> CharacterClass,
+                                                 const FTransform& Transform)
+{
+	if (!CharacterClass)
+	{
+		return FMassEntityHandle();
+	}
+
+	const AALSBaseCharacter* Defaults = CharacterClass->GetDefaultObject<AALSBaseCharacter>();
+	TSharedPtr<const FALSMovementModel> MovementModel = FALSMovementModelCache::Get(
+		Defaults->GetMovementModelHandle());
+	if (!MovementModel)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ALS crowd agent of class %s has no valid movement model"),
+		       *CharacterClass->GetName());
+		return FMassEntityHandle();
+	}
+
+	FMassEntityManager& EntityManager = GetEntityManager();
+	const FMassEntityHandle Agent = EntityManager.CreateEntity(AgentArchetype);
+
+	FALSCrowdTransformFragment& AgentTransform = EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agent);
+	AgentTransform.Location = Transform.GetLocation();
+	AgentTransform.Yaw = Transform.Rotator().Yaw;
+	AgentTransform.TargetYaw = AgentTransform.Yaw;
+
+	FALSCrowdMovementFragment& Movement = EntityManager.GetFragmentDataChecked<FALSCrowdMovementFragment>(Agent);
+	Movement.LastVelocityYaw = AgentTransform.Yaw;
+	Movement.AimYaw = AgentTransform.Yaw;
+
+	FALSCrowdStateFragment& State = EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent);
+	State.DesiredGait = Defaults->GetDesiredGait();
+	State.Stance = Defaults->GetDesiredStance();
+	State.RotationMode = Defaults->GetDesiredRotationMode();
+	State.OverlayState = Defaults->GetOverlayState();
+
+	FALSCrowdAgentFragment& AgentData = EntityManager.GetFragmentDataChecked<FALSCrowdAgentFragment>(Agent);
+	AgentData.MovementModel = MoveTemp(MovementModel);
+	AgentData.CharacterClass = CharacterClass;
+	AgentClasses.AddUnique(CharacterClass);
+
+	Agents.Add(Agent);
+	INC_DWORD_STAT(STAT_ALS_CrowdAgents);
+	return Agent;
+}
+
+void UALSCrowdSubsystem::DestroyAgent(FMassEntityHandle Agent)
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+	if (!EntityManager.IsEntityValid(Agent))
+	{
+		return;
+	}
+
+	if (AALSBaseCharacter* Character = GetAgentActor(Agent))
+	{
+		if (UALSCharacterPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UALSCharacterPoolSubsystem>())
+		{
+			PoolSubsystem->ReleaseCharacter(Character);
+		}
+		else
+		{
+			Character->Destroy();
+		}
+	}
+
+	if (HydratedAgents.RemoveSwap(Agent) > 0)
+	{
+		DEC_DWORD_STAT(STAT_ALS_HydratedCrowdAgents);
+	}
+	Agents.RemoveSwap(Agent);
+	EntityManager.DestroyEntity(Agent);
+	DEC_DWORD_STAT(STAT_ALS_CrowdAgents);
+}
+
+void UALSCrowdSubsystem::SetAgentMovementInput(FMassEntityHandle Agent, const FVector& MovementInput, float AimYaw,
+                                               EALSGait DesiredGait)
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+	if (!EntityManager.IsEntityValid(Agent))
+	{
+		return;
+	}
+
+	FALSCrowdMovementFragment& Movement = EntityManager.GetFragmentDataChecked<FALSCrowdMovementFragment>(Agent);
+	Movement.MovementInput = FVector(MovementInput.X, MovementInput.Y, 0.0f).GetClampedToMaxSize(1.0f);
+	Movement.AimYaw = AimYaw;
+	EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent).DesiredGait = DesiredGait;
+}
+
+void UALSCrowdSubsystem::SetAgentStates(FMassEntityHandle Agent, EALSStance Stance, EALSRotationMode RotationMode,
+                                        EALSOverlayState OverlayState)
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+	if (!EntityManager.IsEntityValid(Agent))
+	{
+		return;
+	}
+
+	if (AALSBaseCharacter* Character = GetAgentActor(Agent))
+	{
+		// The character copies its states back to the agent on the next sync. Desired states are only applied by
+		// player input, so the current ones are set as well.
+		Character->SetDesiredStance(Stance);
+		Character->SetDesiredRotationMode(RotationMode);
+		Character->SetRotationMode(RotationMode);
+		Character->SetOverlayState(OverlayState);
+		if (Stance != Character->GetStance())
+		{
+			Stance == EALSStance::Crouching ? Character->Crouch() : Character->UnCrouch();
+			Character->SetStance(Stance);
+		}
+		return;
+	}
+
+	FALSCrowdStateFragment& State = EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent);
+	State.Stance = Stance;
+	State.RotationMode = RotationMode;
+	State.OverlayState = OverlayState;
+}
+
+AALSBaseCharacter* UALSCrowdSubsystem::GetAgentActor(FMassEntityHandle Agent) const
+{
+	const FMassEntityManager& EntityManager = GetEntityManager();
+	if (!EntityManager.IsEntityValid(Agent))
+	{
+		return nullptr;
+	}
+	return EntityManager.GetFragmentDataChecked<FALSCrowdAgentFragment>(Agent).Actor.Get();
+}
+
+int32 UALSCrowdSubsystem::SpawnCrowd(TSubclassOf<AALSBaseCharacter> CharacterClass,
+                                     const TArray<FTransform>& Transforms)
+{
+	int32 NumSpawned = 0;
+	for (const FTransform& Transform : Transforms)
+	{
+		NumSpawned += SpawnAgent(CharacterClass, Transform).IsSet() ? 1 : 0;
+	}
+	return NumSpawned;
+}
+
+void UALSCrowdSubsystem::Simulate(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CrowdSimulate);
+
+	SyncHydratedAgents();
+
+	if (bEnableHydration)
+	{
+		TimeSinceHydrationUpdate += DeltaTime;
+		if (TimeSinceHydrationUpdate >= HydrationUpdateInterval)
+		{
+			TimeSinceHydrationUpdate = 0.0f;
+			UpdateHydration();
+		}
+	}
+
+	FMassProcessingContext ProcessingContext(GetEntityManager(), DeltaTime);
+	UE::Mass::Executor::Run(Pipeline, ProcessingContext);
+}
+
+void UALSCrowdSubsystem::SyncHydratedAgents()
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+	for (int32 Index = HydratedAgents.Num() - 1; Index >= 0; --Index)
+	{
+		const FMassEntityHandle Agent = HydratedAgents[Index];
+		AALSBaseCharacter* Character = GetAgentActor(Agent);
+		if (!Character)
+		{
+			// Character was destroyed by gameplay, continue simulating from the last copied state
+			HydratedAgents.RemoveAtSwap(Index);
+			DEC_DWORD_STAT(STAT_ALS_HydratedCrowdAgents);
+			EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent).MovementState =
+				EALSMovementState::Grounded;
+			EntityManager.RemoveTagFromEntity(Agent, FALSCrowdHydratedTag::StaticStruct());
+			continue;
+		}
+
+		const FALSCrowdMovementFragment& Movement = EntityManager.GetFragmentDataChecked<FALSCrowdMovementFragment>(Agent);
+		const EALSGait DesiredGait = EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent).DesiredGait;
+		if (Character->GetDesiredGait() != DesiredGait)
+		{
+			Character->SetDesiredGait(DesiredGait);
+		}
+		if (!Movement.MovementInput.IsNearlyZero())
+		{
+			Character->AddMovementInput(Movement.MovementInput.GetSafeNormal(), Movement.MovementInput.Size());
+		}
+
+		CopyCharacterState(Agent, *Character);
+	}
+}
+
+void UALSCrowdSubsystem::CopyCharacterState(FMassEntityHandle Agent, const AALSBaseCharacter& Character) const
+{
+	FMassEntityManager& EntityManager = GetEntityManager();
+
+	FALSCrowdTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agent);
+	Transform.Location = Character.GetActorLocation();
+	Transform.Yaw = Character.GetActorRotation().Yaw;
+	Transform.TargetYaw = Transform.Yaw;
+
+	FALSCrowdMovementFragment& Movement = EntityManager.GetFragmentDataChecked<FALSCrowdMovementFragment>(Agent);
+	Movement.Velocity = Character.GetVelocity();
+	Movement.Speed = Character.GetSpeed();
+	if (Movement.Speed > 1.0f)
+	{
+		Movement.LastVelocityYaw = Movement.Velocity.Rotation().Yaw;
+	}
+
+	FALSCrowdStateFragment& State = EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent);
+	State.MovementState = Character.GetMovementState();
+	State.Gait = Character.GetGait();
+	State.Stance = Character.GetStance();
+	State.RotationMode = Character.GetRotationMode();
+	State.OverlayState = Character.GetOverlayState();
+}
+
+void UALSCrowdSubsystem::UpdateHydration()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_CrowdHydration);
+
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (Controller)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	// No viewers (e.g. headless runs) keeps the whole crowd in Mass
+	auto GetClosestViewDistanceSquared = [&ViewLocations](const FVector& Location)
+	{
+		float ClosestDistSq = TNumericLimits<float>::Max();
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(ViewLocation, Location));
+		}
+		return ClosestDistSq;
+	};
+
+	FMassEntityManager& EntityManager = GetEntityManager();
+
+	for (int32 Index = HydratedAgents.Num() - 1; Index >= 0; --Index)
+	{
+		const FMassEntityHandle Agent = HydratedAgents[Index];
+		const FVector& Location = EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agent).Location;
+		if (GetClosestViewDistanceSquared(Location) > FMath::Square(DehydrationDistance))
+		{
+			DehydrateAgent(Agent);
+		}
+	}
+
+	const int32 NumFree = FMath::Min(MaxHydrationsPerUpdate, MaxHydratedAgents - HydratedAgents.Num());
+	if (NumFree <= 0 || ViewLocations.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<TPair<float, FMassEntityHandle>> Candidates;
+	const float HydrationDistSq = FMath::Square(HydrationDistance);
+	for (const FMassEntityHandle& Agent : Agents)
+	{
+		const FALSCrowdAgentFragment& AgentData = EntityManager.GetFragmentDataChecked<FALSCrowdAgentFragment>(Agent);
+		if (AgentData.Actor.IsValid())
+		{
+			continue;
+		}
+
+		const float DistSq = GetClosestViewDistanceSquared(
+			EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agent).Location);
+		if (DistSq < HydrationDistSq)
+		{
+			Candidates.Emplace(DistSq, Agent);
+		}
+	}
+
+	Candidates.Sort([](const TPair<float, FMassEntityHandle>& A, const TPair<float, FMassEntityHandle>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	for (int32 Index = 0; Index < FMath::Min(NumFree, Candidates.Num()); ++Index)
+	{
+		HydrateAgent(Candidates[Index].Value);
+	}
+}
+
+bool UALSCrowdSubsystem::HydrateAgent(FMassEntityHandle Agent)
+{
+	UALSCharacterPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UALSCharacterPoolSubsystem>();
+	if (!PoolSubsystem)
+	{
+		return false;
+	}
+
+	FMassEntityManager& EntityManager = GetEntityManager();
+	FALSCrowdAgentFragment& AgentData = EntityManager.GetFragmentDataChecked<FALSCrowdAgentFragment>(Agent);
+	const FALSCrowdTransformFragment& Transform = EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agent);
+	const FALSCrowdMovementFragment& Movement = EntityManager.GetFragmentDataChecked<FALSCrowdMovementFragment>(Agent);
+	const FALSCrowdStateFragment& State = EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent);
+
+	// Agents keep the height they were spawned or dehydrated at, place the character on the ground below them.
+	// Only static geometry is traced, so the character doesn't end up on top of another one.
+	FVector Location = Transform.Location;
+	const FVector TraceOffset(0.0f, 0.0f, HydrationGroundTraceDistance);
+	FHitResult Hit;
+	if (GetWorld()->LineTraceSingleByObjectType(Hit, Location + TraceOffset, Location - TraceOffset,
+	                                            FCollisionObjectQueryParams(ECC_WorldStatic),
+	                                            FCollisionQueryParams(SCENE_QUERY_STAT(ALSCrowdHydration), false)))
+	{
+		const AALSBaseCharacter* Defaults = AgentData.CharacterClass->GetDefaultObject<AALSBaseCharacter>();
+		Location.Z = Hit.ImpactPoint.Z + Defaults->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + 2.0f;
+	}
+
+	AALSBaseCharacter* Character = PoolSubsystem->AcquireCharacter(
+		AgentData.CharacterClass, FTransform(FRotator(0.0f, Transform.Yaw, 0.0f), Location));
+	if (!Character)
+	{
+		return false;
+	}
+
+	if (!Character->GetController())
+	{
+		Character->SpawnDefaultController();
+	}
+
+	// Carry on from the agent state, ResetALSState already faced the character to the agent rotation. Desired states
+	// are only applied by player input, so the current ones are set as well, otherwise the character keeps the class
+	// defaults and copies them back to the agent.
+	Character->SetDesiredGait(State.DesiredGait);
+	Character->SetGait(State.Gait);
+	Character->SetDesiredStance(State.Stance);
+	Character->SetDesiredRotationMode(State.RotationMode);
+	Character->SetRotationMode(State.RotationMode);
+	Character->SetStance(State.Stance);
+	Character->SetOverlayState(State.OverlayState);
+	if (State.Stance == EALSStance::Crouching)
+	{
+		Character->Crouch();
+	}
+	Character->GetCharacterMovement()->Velocity = Movement.Velocity;
+
+	AgentData.Actor = Character;
+	HydratedAgents.Add(Agent);
+	INC_DWORD_STAT(STAT_ALS_HydratedCrowdAgents);
+
+	// Changes the archetype of the agent, fragment references above are invalid after this point
+	EntityManager.AddTagToEntity(Agent, FALSCrowdHydratedTag::StaticStruct());
+	return true;
+}
+
+bool UALSCrowdSubsystem::DehydrateAgent(FMassEntityHandle Agent)
+{
+	AALSBaseCharacter* Character = GetAgentActor(Agent);
+	if (!Character)
+	{
+		return false;
+	}
+
+	// Agents only simulate grounded movement, wait for the character to land and finish its action
+	if (Character->GetMovementState() != EALSMovementState::Grounded ||
+		Character->GetMovementAction() != EALSMovementAction::None)
+	{
+		return false;
+	}
+
+	CopyCharacterState(Agent, *Character);
+
+	FMassEntityManager& EntityManager = GetEntityManager();
+	EntityManager.GetFragmentDataChecked<FALSCrowdAgentFragment>(Agent).Actor.Reset();
+	if (UALSCharacterPoolSubsystem* PoolSubsystem = GetWorld()->GetSubsystem<UALSCharacterPoolSubsystem>())
+	{
+		PoolSubsystem->ReleaseCharacter(Character);
+	}
+	else
+	{
+		Character->Destroy();
+	}
+
+	HydratedAgents.RemoveSwap(Agent);
+	DEC_DWORD_STAT(STAT_ALS_HydratedCrowdAgents);
+	EntityManager.RemoveTagFromEntity(Agent, FALSCrowdHydratedTag::StaticStruct());
+	return true;
+}
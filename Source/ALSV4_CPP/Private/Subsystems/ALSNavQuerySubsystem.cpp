@@ -0,0 +1,177 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Subsystems/ALSNavQuerySubsystem.h"
+
+#include "Library/ALSStats.h"
+
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Random Location Query"), STAT_ALS_RandomLocationQuery, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Random Location Queries"), STAT_ALS_RandomLocationQueries, STATGROUP_ALS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Random Locations From Pool"), STAT_ALS_RandomLocationsPooled, STATGROUP_ALS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Random Location Queries"), STAT_ALS_PendingRandomLocations, STATGROUP_ALS);
+
+
+void UALSNavQuerySubsystem::Tick(float DeltaTime)
+{
+	SET_DWORD_STAT(STAT_ALS_PendingRandomLocations, PendingRequests.Num());
+
+	if (PendingRequests.Num() == 0)
+	{
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys
+		                                 ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)
+		                                 : nullptr;
+
+	// Requests are served in order, callbacks may queue new requests which wait for the next frame
+	const int32 NumToRun = FMath::Min(PendingRequests.Num(), MaxQueriesPerFrame);
+	TArray<FRequest> Requests(PendingRequests.GetData(), NumToRun);
+	PendingRequests.RemoveAt(0, NumToRun, false);
+
+	for (FRequest& Request : Requests)
+	{
+		FNavLocation Destination;
+		bool bSuccess = false;
+		if (NavData)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_ALS_RandomLocationQuery);
+			INC_DWORD_STAT(STAT_ALS_RandomLocationQueries);
+
+			const FSharedConstNavQueryFilter SharedFilter = Request.Filter ? GetQueryFilter(*NavData, Request.Filter) : nullptr;
+			bSuccess = NavSys->GetRandomReachablePointInRadius(Request.Origin, Request.Radius, Destination,
+			                                                   NavData, SharedFilter);
+		}
+
+		if (bSuccess && Request.bAddToPointPool)
+		{
+			AddPooledPoint(Request.Origin, Request.Filter, Destination.Location);
+		}
+
+		Request.Callback.ExecuteIfBound(bSuccess, Destination.Location);
+	}
+}
+
+TStatId UALSNavQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSNavQuerySubsystem, STATGROUP_Tickables);
+}
+
+uint32 UALSNavQuerySubsystem::RequestRandomReachablePoint(const FVector& Origin, float Radius,
+                                                          TSubclassOf<UNavigationQueryFilter> Filter,
+                                                          bool bAddToPointPool, FALSRandomLocationDelegate Callback)
+{
+	FRequest& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Id = NextRequestId++;
+	Request.Origin = Origin;
+	Request.Radius = Radius;
+	Request.Filter = Filter;
+	Request.bAddToPointPool = bAddToPointPool;
+	Request.Callback = MoveTemp(Callback);
+
+	// Zero is kept for "no request"
+	if (NextRequestId == 0)
+	{
+		NextRequestId = 1;
+	}
+	return Request.Id;
+}
+
+void UALSNavQuerySubsystem::CancelRequest(uint32 RequestId)
+{
+	PendingRequests.RemoveAll([RequestId](const FRequest& Request) { return Request.Id == RequestId; });
+}
+
+bool UALSNavQuerySubsystem::TryGetPooledPoint(const FVector& Origin, float Radius,
+                                              TSubclassOf<UNavigationQueryFilter> Filter, FVector& OutLocation)
+{
+	FPointPool* Pool = PointPools.Find(GetPointPoolKey(Origin, Filter));
+	if (!Pool)
+	{
+		return false;
+	}
+
+	if (GetWorld()->GetTimeSeconds() - Pool->CreationTime > PointPoolLifetime)
+	{
+		PointPools.Remove(GetPointPoolKey(Origin, Filter));
+		return false;
+	}
+
+	if (Pool->Points.Num() < PointPoolSize)
+	{
+		return false;
+	}
+
+	// Start at a random point and take the first one inside the radius
+	const float RadiusSquared = FMath::Square(Radius);
+	const int32 Start = FMath::RandHelper(Pool->Points.Num());
+	for (int32 Offset = 0; Offset < Pool->Points.Num(); ++Offset)
+	{
+		const FVector& Point = Pool->Points[(Start + Offset) % Pool->Points.Num()];
+		if (FVector::DistSquared(Point, Origin) <= RadiusSquared)
+		{
+			INC_DWORD_STAT(STAT_ALS_RandomLocationsPooled);
+			OutLocation = Point;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+FSharedConstNavQueryFilter UALSNavQuerySubsystem::GetQueryFilter(const ANavigationData& NavData,
+                                                                TSubclassOf<UNavigationQueryFilter> Filter)
+{
+	const TPair<TWeakObjectPtr<const ANavigationData>, UClass*> Key(&NavData, Filter.Get());
+	if (const FSharedConstNavQueryFilter* Cached = QueryFilters.Find(Key))
+	{
+		return *Cached;
+	}
+
+	// Drop filters of unloaded nav data before caching a new one
+	for (auto It = QueryFilters.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FSharedConstNavQueryFilter SharedFilter = UNavigationQueryFilter::GetQueryFilter(NavData, GetWorld(), Filter);
+	QueryFilters.Add(Key, SharedFilter);
+	return SharedFilter;
+}
+
+UALSNavQuerySubsystem::FPointPoolKey UALSNavQuerySubsystem::GetPointPoolKey(
+	const FVector& Location, TSubclassOf<UNavigationQueryFilter> Filter) const
+{
+	return FPointPoolKey(Filter.Get(), FIntPoint(FMath::FloorToInt(Location.X / PointPoolCellSize),
+	                                             FMath::FloorToInt(Location.Y / PointPoolCellSize)));
+}
+
+void UALSNavQuerySubsystem::AddPooledPoint(const FVector& Origin, TSubclassOf<UNavigationQueryFilter> Filter,
+                                           const FVector& Point)
+{
+	const FPointPoolKey Key = GetPointPoolKey(Origin, Filter);
+	FPointPool* Pool = PointPools.Find(Key);
+	if (!Pool)
+	{
+		Pool = &PointPools.Add(Key);
+		Pool->CreationTime = GetWorld()->GetTimeSeconds();
+	}
+
+	if (Pool->Points.Num() < PointPoolSize)
+	{
+		Pool->Points.Add(Point);
+	}
+	else
+	{
+		// Keep the pool varied by replacing a random point
+		Pool->Points[FMath::RandHelper(Pool->Points.Num())] = Point;
+	}
+}
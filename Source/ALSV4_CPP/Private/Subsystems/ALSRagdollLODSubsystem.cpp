@@ -0,0 +1,186 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Subsystems/ALSRagdollLODSubsystem.h"
+
+#include "Character/ALSBaseCharacter.h"
+#include "GameFramework/PlayerController.h"
+#include "Library/ALSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ragdoll LOD Update"), STAT_ALS_RagdollLODUpdate, STATGROUP_ALS);
+
+
+void UALSRagdollLODSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (ActiveRagdolls.Num() > 0)
+	{
+		TimeSinceLastUpdate += DeltaTime;
+		if (TimeSinceLastUpdate >= UpdateInterval)
+		{
+			TimeSinceLastUpdate = 0.0f;
+			UpdateRagdollLODs();
+		}
+	}
+
+#if STATS || CSV_PROFILER
+	int32 NumRagdolls[3] = {0, 0, 0};
+	int32 NumSettled = 0;
+	for (const TWeakObjectPtr<AALSBaseCharacter>& Ragdoll : ActiveRagdolls)
+	{
+		if (Ragdoll.IsValid())
+		{
+			NumRagdolls[static_cast<int32>(Ragdoll->GetRagdollLOD())]++;
+			NumSettled += Ragdoll->IsRagdollSettled() ? 1 : 0;
+		}
+	}
+	SET_DWORD_STAT(STAT_ALS_FullRagdolls, NumRagdolls[static_cast<int32>(EALSRagdollLOD::Full)]);
+	SET_DWORD_STAT(STAT_ALS_ReducedRagdolls, NumRagdolls[static_cast<int32>(EALSRagdollLOD::Reduced)]);
+	SET_DWORD_STAT(STAT_ALS_SimpleRagdolls, NumRagdolls[static_cast<int32>(EALSRagdollLOD::Simple)]);
+	SET_DWORD_STAT(STAT_ALS_SettledRagdolls, NumSettled);
+	CSV_CUSTOM_STAT(ALS, FullRagdolls, NumRagdolls[static_cast<int32>(EALSRagdollLOD::Full)], ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ALS, ReducedRagdolls, NumRagdolls[static_cast<int32>(EALSRagdollLOD::Reduced)], ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ALS, SimpleRagdolls, NumRagdolls[static_cast<int32>(EALSRagdollLOD::Simple)], ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(ALS, SettledRagdolls, NumSettled, ECsvCustomStatOp::Set);
+#endif
+}
+
+TStatId UALSRagdollLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSRagdollLODSubsystem, STATGROUP_Tickables);
+}
+
+EALSRagdollLOD UALSRagdollLODSubsystem::RegisterRagdoll(AALSBaseCharacter* Character)
+{
+	check(Character);
+
+	ActiveRagdolls.AddUnique(Character);
+
+	int32 NumFull = 0;
+	for (const TWeakObjectPtr<AALSBaseCharacter>& Ragdoll : ActiveRagdolls)
+	{
+		if (Ragdoll.IsValid() && Ragdoll.Get() != Character && !Ragdoll->IsRagdollSettled() &&
+			Ragdoll->GetRagdollLOD() == EALSRagdollLOD::Full)
+		{
+			NumFull++;
+		}
+	}
+
+	// Ragdolls starting in the same frame are assigned in the registration order, the next tier update
+	// will promote the closest ones if the full ragdoll budget was filled by further ones.
+	GatherViewLocations();
+	const EALSRagdollLOD DesiredLOD = GetDesiredLOD(EALSRagdollLOD::Simple,
+	                                                GetClosestViewDistanceSquared(Character->GetActorLocation()));
+	if (DesiredLOD == EALSRagdollLOD::Full && NumFull >= MaxFullRagdolls)
+	{
+		return EALSRagdollLOD::Reduced;
+	}
+	return DesiredLOD;
+}
+
+void UALSRagdollLODSubsystem::UnregisterRagdoll(AALSBaseCharacter* Character)
+{
+	ActiveRagdolls.Remove(Character);
+}
+
+void UALSRagdollLODSubsystem::GatherViewLocations()
+{
+	ViewLocations.Reset();
+
+	const UWorld* World = GetWorld();
+	check(World);
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (Controller)
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+}
+
+float UALSRagdollLODSubsystem::GetClosestViewDistanceSquared(const FVector& Location) const
+{
+	if (ViewLocations.Num() == 0)
+	{
+		// No viewers (e.g. headless runs), treat every ragdoll as close
+		return 0.0f;
+	}
+
+	float ClosestDistSq = TNumericLimits<float>::Max();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(ViewLocation, Location));
+	}
+	return ClosestDistSq;
+}
+
+EALSRagdollLOD UALSRagdollLODSubsystem::GetDesiredLOD(EALSRagdollLOD CurrentLOD, float DistanceSquared) const
+{
+	// Apply the buffer only for demotion, so a ragdoll on the tier boundary doesn't keep swapping its physics asset.
+	const float FullDist = CurrentLOD == EALSRagdollLOD::Full ? FullDistance + DistanceBuffer : FullDistance;
+	const float ReducedDist = CurrentLOD != EALSRagdollLOD::Simple ? ReducedDistance + DistanceBuffer : ReducedDistance;
+
+	if (DistanceSquared < FMath::Square(FullDist))
+	{
+		return EALSRagdollLOD::Full;
+	}
+	if (DistanceSquared < FMath::Square(ReducedDist))
+	{
+		return EALSRagdollLOD::Reduced;
+	}
+	return EALSRagdollLOD::Simple;
+}
+
+void UALSRagdollLODSubsystem::UpdateRagdollLODs()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_RagdollLODUpdate);
+
+	ActiveRagdolls.RemoveAll([](const TWeakObjectPtr<AALSBaseCharacter>& Ragdoll)
+	{
+		return !Ragdoll.IsValid();
+	});
+
+	GatherViewLocations();
+
+	// Settled ragdolls are sleeping and keep their tier, swapping physics assets would wake them up.
+	TArray<TPair<float, AALSBaseCharacter*>> SortedRagdolls;
+	SortedRagdolls.Reserve(ActiveRagdolls.Num());
+	for (const TWeakObjectPtr<AALSBaseCharacter>& Ragdoll : ActiveRagdolls)
+	{
+		if (!Ragdoll->IsRagdollSettled())
+		{
+			SortedRagdolls.Emplace(GetClosestViewDistanceSquared(Ragdoll->GetActorLocation()), Ragdoll.Get());
+		}
+	}
+
+	SortedRagdolls.Sort([](const TPair<float, AALSBaseCharacter*>& A, const TPair<float, AALSBaseCharacter*>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	// Closest ragdolls are promoted to full tier first, the rest are demoted once the budget is filled.
+	int32 NumFull = 0;
+	for (const TPair<float, AALSBaseCharacter*>& Ragdoll : SortedRagdolls)
+	{
+		EALSRagdollLOD DesiredLOD = GetDesiredLOD(Ragdoll.Value->GetRagdollLOD(), Ragdoll.Key);
+		if (DesiredLOD == EALSRagdollLOD::Full)
+		{
+			if (NumFull < MaxFullRagdolls)
+			{
+				NumFull++;
+			}
+			else
+			{
+				DesiredLOD = EALSRagdollLOD::Reduced;
+			}
+		}
+		Ragdoll.Value->SetRagdollLOD(DesiredLOD);
+	}
+}
@@ -0,0 +1,371 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Subsystems/ALSSceneQuerySubsystem.h"
+
+#include "Engine/World.h"
+#include "Library/ALSStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Scene Query"), STAT_ALS_SceneQuery, STATGROUP_ALS);
+
+static void CountExecutedQuery(EALSSceneQueryType QueryType)
+{
+	switch (QueryType)
+	{
+	case EALSSceneQueryType::FootIK:
+		INC_DWORD_STAT(STAT_ALS_FootIKTraces);
+		CSV_CUSTOM_STAT(ALS, FootIKTraces, 1, ECsvCustomStatOp::Accumulate);
+		break;
+	case EALSSceneQueryType::LandPrediction:
+		INC_DWORD_STAT(STAT_ALS_LandPredictionTraces);
+		CSV_CUSTOM_STAT(ALS, LandPredictionTraces, 1, ECsvCustomStatOp::Accumulate);
+		break;
+	case EALSSceneQueryType::Camera:
+		INC_DWORD_STAT(STAT_ALS_CameraTraces);
+		CSV_CUSTOM_STAT(ALS, CameraTraces, 1, ECsvCustomStatOp::Accumulate);
+		break;
+	case EALSSceneQueryType::Mantle:
+		INC_DWORD_STAT(STAT_ALS_MantleTraces);
+		CSV_CUSTOM_STAT(ALS, MantleTraces, 1, ECsvCustomStatOp::Accumulate);
+		break;
+	case EALSSceneQueryType::Ragdoll:
+		INC_DWORD_STAT(STAT_ALS_RagdollTraces);
+		CSV_CUSTOM_STAT(ALS, RagdollTraces, 1, ECsvCustomStatOp::Accumulate);
+		break;
+	case EALSSceneQueryType::Footstep:
+		INC_DWORD_STAT(STAT_ALS_FootstepTraces);
+		CSV_CUSTOM_STAT(ALS, FootstepTraces, 1, ECsvCustomStatOp::Accumulate);
+		break;
+	}
+}
+
+static bool CanDeferQuery(EALSSceneQueryType QueryType)
+{
+	// Camera and mantle results directly affect the player, and a footstep spawns its effects once at the hit.
+	// An older result is wrong for them whatever the budget and significance are.
+	return QueryType != EALSSceneQueryType::Camera && QueryType != EALSSceneQueryType::Mantle &&
+		QueryType != EALSSceneQueryType::Footstep;
+}
+
+UALSSceneQuerySubsystem::UALSSceneQuerySubsystem()
+{
+	QueryPriorities.Add(EALSSceneQueryType::Ragdoll, 0.75f);
+	QueryPriorities.Add(EALSSceneQueryType::LandPrediction, 0.5f);
+	QueryPriorities.Add(EALSSceneQueryType::FootIK, 0.5f);
+}
+
+template <typename QueryFunc>
+bool UALSSceneQuerySubsystem::RunQuery(EALSSceneQueryType QueryType, const AActor* Owner, int32 QueryKey,
+                                       FHitResult& OutHit, const FVector& Start, const FVector& End,
+                                       QueryFunc&& Query, bool* bOutExecuted)
+{
+	BeginFrame();
+
+	SCOPE_CYCLE_COUNTER(STAT_ALS_SceneQuery);
+
+	FrameStats.Requested++;
+	TotalStats.Requested++;
+
+	FQueryResult& Result = Results.FindOrAdd(FQueryId(Owner, QueryType, QueryKey));
+	const bool bHasResult = Result.Frame != 0;
+
+	// Same query was already executed this frame, e.g. from two anim graph updates.
+	if (bHasResult && Result.Frame == CurrentFrame &&
+		Result.Start.Equals(Start, 1.0f) && Result.End.Equals(End, 1.0f))
+	{
+		FrameStats.Reused++;
+		TotalStats.Reused++;
+		INC_DWORD_STAT(STAT_ALS_ReusedTraces);
+		CSV_CUSTOM_STAT(ALS, ReusedTraces, 1, ECsvCustomStatOp::Accumulate);
+		OutHit = Result.Hit;
+		return Result.bHit;
+	}
+
+	// Lower priority queries are allowed to use a smaller share of the frame budget, so the remaining budget is
+	// kept for higher priority ones. Queries without a previous result or deferred for too long always run.
+	const float Priority = GetPriority(QueryType, Owner);
+	const bool bWithinBudget = Priority >= 1.0f || FrameStats.Executed < MaxQueriesPerFrame * Priority;
+	const bool bStarving = CurrentFrame - Result.Frame > static_cast<uint64>(MaxDeferredFrames);
+	if (CanDeferQuery(QueryType) && bHasResult && !bWithinBudget && !bStarving)
+	{
+		FrameStats.Deferred++;
+		TotalStats.Deferred++;
+		INC_DWORD_STAT(STAT_ALS_DeferredTraces);
+		CSV_CUSTOM_STAT(ALS, DeferredTraces, 1, ECsvCustomStatOp::Accumulate);
+		bool bHit = false;
+		MoveResult(Result, Start, End, OutHit, bHit);
+		return bHit;
+	}
+
+	if (bOutExecuted)
+	{
+		*bOutExecuted = true;
+	}
+
+	FrameStats.Executed++;
+	TotalStats.Executed++;
+	CountExecutedQuery(QueryType);
+	Result.bHit = Query(OutHit);
+	Result.Hit = OutHit;
+	Result.Start = Start;
+	Result.End = End;
+	Result.Frame = CurrentFrame;
+	return Result.bHit;
+}
+
+bool UALSSceneQuerySubsystem::LineTraceSingleByChannel(const UWorld* World, EALSSceneQueryType QueryType,
+                                                       const AActor* Owner, int32 QueryKey, FHitResult& OutHit,
+                                                       const FVector& Start, const FVector& End,
+                                                       ECollisionChannel TraceChannel,
+                                                       const FCollisionQueryParams& Params)
+{
+	check(World);
+
+	auto Query = [&](FHitResult& Hit)
+	{
+		return World->LineTraceSingleByChannel(Hit, Start, End, TraceChannel, Params);
+	};
+
+	if (UALSSceneQuerySubsystem* Subsystem = World->GetSubsystem<UALSSceneQuerySubsystem>())
+	{
+		return Subsystem->RunQuery(QueryType, Owner, QueryKey, OutHit, Start, End, Query);
+	}
+	return Query(OutHit);
+}
+
+bool UALSSceneQuerySubsystem::SweepSingleByChannel(const UWorld* World, EALSSceneQueryType QueryType,
+                                                   const AActor* Owner, int32 QueryKey, FHitResult& OutHit,
+                                                   const FVector& Start, const FVector& End,
+                                                   ECollisionChannel TraceChannel,
+                                                   const FCollisionShape& CollisionShape,
+                                                   const FCollisionQueryParams& Params)
+{
+	check(World);
+
+	auto Query = [&](FHitResult& Hit)
+	{
+		return World->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, TraceChannel, CollisionShape, Params);
+	};
+
+	if (UALSSceneQuerySubsystem* Subsystem = World->GetSubsystem<UALSSceneQuerySubsystem>())
+	{
+		return Subsystem->RunQuery(QueryType, Owner, QueryKey, OutHit, Start, End, Query);
+	}
+	return Query(OutHit);
+}
+
+bool UALSSceneQuerySubsystem::SweepSingleByProfile(const UWorld* World, EALSSceneQueryType QueryType,
+                                                   const AActor* Owner, int32 QueryKey, FHitResult& OutHit,
+                                                   const FVector& Start, const FVector& End, FName ProfileName,
+                                                   const FCollisionShape& CollisionShape,
+                                                   const FCollisionQueryParams& Params)
+{
+	check(World);
+
+	auto Query = [&](FHitResult& Hit)
+	{
+		return World->SweepSingleByProfile(Hit, Start, End, FQuat::Identity, ProfileName, CollisionShape, Params);
+	};
+
+	if (UALSSceneQuerySubsystem* Subsystem = World->GetSubsystem<UALSSceneQuerySubsystem>())
+	{
+		return Subsystem->RunQuery(QueryType, Owner, QueryKey, OutHit, Start, End, Query);
+	}
+	return Query(OutHit);
+}
+
+bool UALSSceneQuerySubsystem::ProbeGround(const UWorld* World, EALSSceneQueryType QueryType, const AActor* Owner,
+                                          int32 QueryKey, FHitResult& OutHit, const FVector& Start, const FVector& End,
+                                          ECollisionChannel TraceChannel, const FCollisionQueryParams& Params)
+{
+	check(World);
+
+	UALSSceneQuerySubsystem* Subsystem = World->GetSubsystem<UALSSceneQuerySubsystem>();
+	if (!Subsystem || !FMath::IsNearlyEqual(Start.X, End.X) || !FMath::IsNearlyEqual(Start.Y, End.Y) || Start.Z <= End.Z)
+	{
+		return LineTraceSingleByChannel(World, QueryType, Owner, QueryKey, OutHit, Start, End, TraceChannel, Params);
+	}
+
+	Subsystem->BeginFrame();
+	Subsystem->FrameStats.GroundProbes++;
+	Subsystem->TotalStats.GroundProbes++;
+	INC_DWORD_STAT(STAT_ALS_GroundProbes);
+	CSV_CUSTOM_STAT(ALS, GroundProbes, 1, ECsvCustomStatOp::Accumulate);
+
+	const FIntPoint Cell(FMath::FloorToInt(Start.X / Subsystem->GroundProbeCellSize),
+	                     FMath::FloorToInt(Start.Y / Subsystem->GroundProbeCellSize));
+	const FGroundProbeId ProbeId(Owner, TraceChannel, Params.bTraceComplex, GetIgnoredHash(Params), Cell);
+
+	bool bHit = false;
+	if (Subsystem->FindGroundProbe(ProbeId, Start, End, Params, OutHit, bHit))
+	{
+		Subsystem->FrameStats.GroundProbesShared++;
+		Subsystem->TotalStats.GroundProbesShared++;
+		INC_DWORD_STAT(STAT_ALS_SharedGroundProbes);
+		CSV_CUSTOM_STAT(ALS, SharedGroundProbes, 1, ECsvCustomStatOp::Accumulate);
+		return bHit;
+	}
+
+	bool bExecuted = false;
+	bHit = Subsystem->RunQuery(QueryType, Owner, QueryKey, OutHit, Start, End, [&](FHitResult& Hit)
+	{
+		return World->LineTraceSingleByChannel(Hit, Start, End, TraceChannel, Params);
+	}, &bExecuted);
+
+	// A deferred result belongs to an earlier frame, sharing it would spread the stale hit to the other systems.
+	if (!bExecuted)
+	{
+		return bHit;
+	}
+
+	// Keep the probe covering the largest height range, it can answer more of the following probes.
+	FGroundProbe& Probe = Subsystem->GroundProbes.FindOrAdd(ProbeId);
+	if (Probe.StartZ - Probe.EndZ < Start.Z - End.Z)
+	{
+		Probe.Hit = OutHit;
+		Probe.StartZ = Start.Z;
+		Probe.EndZ = End.Z;
+		Probe.bHit = bHit;
+		Probe.bReturnPhysicalMaterial = Params.bReturnPhysicalMaterial;
+	}
+	return bHit;
+}
+
+FCollisionQueryParams UALSSceneQuerySubsystem::MakeGroundProbeParams(const AActor* Owner)
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(ALSGroundProbe), true /*bTraceComplex*/);
+	Params.bReturnPhysicalMaterial = true;
+	if (Owner)
+	{
+		Params.AddIgnoredActor(Owner);
+		Params.AddIgnoredActors(Owner->Children);
+	}
+	return Params;
+}
+
+uint32 UALSSceneQuerySubsystem::GetIgnoredHash(const FCollisionQueryParams& Params)
+{
+	// Summed, so the same set of ignored ids gives the same hash in whatever order it was added.
+	uint32 Hash = 0;
+	for (const uint32 ActorId : Params.GetIgnoredActors())
+	{
+		Hash += MurmurFinalize32(ActorId);
+	}
+	for (const uint32 ComponentId : Params.GetIgnoredComponents())
+	{
+		Hash += MurmurFinalize32(~ComponentId);
+	}
+	return Hash;
+}
+
+bool UALSSceneQuerySubsystem::FindGroundProbe(const FGroundProbeId& ProbeId, const FVector& Start, const FVector& End,
+                                              const FCollisionQueryParams& Params, FHitResult& OutHit,
+                                              bool& bOutHit) const
+{
+	const FGroundProbe* Probe = GroundProbes.Find(ProbeId);
+	if (!Probe || Probe->StartZ < Start.Z || Probe->EndZ > End.Z ||
+		(Params.bReturnPhysicalMaterial && !Probe->bReturnPhysicalMaterial) || Probe->Hit.bStartPenetrating)
+	{
+		return false;
+	}
+
+	const float ImpactZ = Probe->Hit.ImpactPoint.Z;
+	if (Probe->bHit && ImpactZ > Start.Z)
+	{
+		// Surface is above the requested start, a trace starting below it may hit something else.
+		return false;
+	}
+
+	if (!Probe->bHit || ImpactZ < End.Z)
+	{
+		OutHit = FHitResult(Start, End);
+		bOutHit = false;
+		return true;
+	}
+
+	// Re-base the shared hit on the requested trace.
+	OutHit = Probe->Hit;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.Distance = Start.Z - ImpactZ;
+	OutHit.Time = OutHit.Distance / (Start.Z - End.Z);
+	OutHit.Location = FVector(Start.X, Start.Y, ImpactZ);
+	OutHit.ImpactPoint.X = Start.X;
+	OutHit.ImpactPoint.Y = Start.Y;
+	bOutHit = true;
+	return true;
+}
+
+void UALSSceneQuerySubsystem::MoveResult(const FQueryResult& Result, const FVector& Start, const FVector& End,
+                                         FHitResult& OutHit, bool& bOutHit)
+{
+	// Queries of a moving owner move with it, e.g. foot IK traces below the feet. Assume the surface moved along.
+	const FVector Offset = Start - Result.Start;
+	const float Length = FVector::Dist(Start, End);
+
+	OutHit = Result.Hit;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	bOutHit = Result.bHit && OutHit.Distance <= Length;
+	if (!bOutHit)
+	{
+		OutHit.Reset(1.0f, false);
+		OutHit.TraceStart = Start;
+		OutHit.TraceEnd = End;
+		OutHit.Location = End;
+		return;
+	}
+
+	OutHit.Location += Offset;
+	OutHit.ImpactPoint += Offset;
+	OutHit.Time = Length > 0.0f ? OutHit.Distance / Length : 0.0f;
+}
+
+void UALSSceneQuerySubsystem::SetSignificance(const AActor* Owner, float Significance)
+{
+	if (Owner)
+	{
+		Significances.Add(Owner, FMath::Clamp(Significance, KINDA_SMALL_NUMBER, 1.0f));
+	}
+}
+
+void UALSSceneQuerySubsystem::BeginFrame()
+{
+	if (CurrentFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	CurrentFrame = GFrameCounter;
+	FrameStats = FALSSceneQueryStats();
+	GroundProbes.Reset();
+
+	// Drop results of queries which are not requested anymore, e.g. owner is destroyed or stopped ragdolling.
+	constexpr uint64 ResultLifetimeFrames = 300;
+	if (CurrentFrame % ResultLifetimeFrames == 0)
+	{
+		for (auto It = Results.CreateIterator(); It; ++It)
+		{
+			if (CurrentFrame - It.Value().Frame > ResultLifetimeFrames)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		for (auto It = Significances.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+float UALSSceneQuerySubsystem::GetPriority(EALSSceneQueryType QueryType, const AActor* Owner) const
+{
+	const float* TypePriority = QueryPriorities.Find(QueryType);
+	const float* Significance = Significances.Find(Owner);
+	return (TypePriority ? *TypePriority : 1.0f) * (Significance ? *Significance : 1.0f);
+}
@@ -0,0 +1,197 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Subsystems/ALSTargetSubsystem.h"
+
+#include "Library/ALSStats.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Hash Update"), STAT_ALS_TargetHashUpdate, STATGROUP_ALS);
+DECLARE_CYCLE_STAT(TEXT("Target Query"), STAT_ALS_TargetQuery, STATGROUP_ALS);
+
+
+void UALSTargetSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_TargetHashUpdate);
+
+	RegisterPlayerPawns();
+
+	for (int32 Index = Targets.Num() - 1; Index >= 0; --Index)
+	{
+		FTarget& Target = Targets[Index];
+		const APawn* Pawn = Target.Pawn.Get();
+		if (!Pawn)
+		{
+			RemoveTargetAt(Index);
+			continue;
+		}
+
+		Target.Location = Pawn->GetActorLocation();
+		Target.FocalPoint = Pawn->GetPawnViewLocation();
+		Target.bIsPlayer = Pawn->IsPlayerControlled();
+
+		const FIntPoint Cell = GetCell(Target.Location);
+		if (Cell != Target.Cell)
+		{
+			RemoveFromCell(Index);
+			Target.Cell = Cell;
+			AddToCell(Index);
+		}
+	}
+}
+
+TStatId UALSTargetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UALSTargetSubsystem, STATGROUP_Tickables);
+}
+
+void UALSTargetSubsystem::RegisterTarget(APawn* Pawn)
+{
+	if (!Pawn || TargetIndices.Contains(Pawn))
+	{
+		return;
+	}
+
+	const int32 Index = Targets.AddDefaulted();
+	FTarget& Target = Targets[Index];
+	Target.Pawn = Pawn;
+	Target.Location = Pawn->GetActorLocation();
+	Target.FocalPoint = Pawn->GetPawnViewLocation();
+	Target.bIsPlayer = Pawn->IsPlayerControlled();
+	Target.Cell = GetCell(Target.Location);
+	TargetIndices.Add(Pawn, Index);
+	AddToCell(Index);
+}
+
+void UALSTargetSubsystem::UnregisterTarget(APawn* Pawn)
+{
+	if (const int32* Index = TargetIndices.Find(Pawn))
+	{
+		RemoveTargetAt(*Index);
+	}
+}
+
+APawn* UALSTargetSubsystem::FindNearestTarget(const FVector& Origin, float MaxDistance,
+                                              EALSFocusTargetType TargetType, const APawn* Querier) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ALS_TargetQuery);
+
+	const FIntPoint Center = GetCell(Origin);
+	const int32 MaxRing = FMath::CeilToInt(MaxDistance / CellSize);
+	float BestDistanceSquared = FMath::Square(MaxDistance);
+	APawn* BestPawn = nullptr;
+
+	// Search rings of cells outwards, stop once the ring is further away than the best match
+	for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+	{
+		if (BestPawn && FMath::Square((Ring - 1) * CellSize) > BestDistanceSquared)
+		{
+			break;
+		}
+
+		for (int32 X = -Ring; X <= Ring; ++X)
+		{
+			for (int32 Y = -Ring; Y <= Ring; ++Y)
+			{
+				if (FMath::Max(FMath::Abs(X), FMath::Abs(Y)) != Ring)
+				{
+					continue;
+				}
+
+				const TArray<int32>* Cell = Cells.Find(Center + FIntPoint(X, Y));
+				if (!Cell)
+				{
+					continue;
+				}
+
+				for (const int32 Index : *Cell)
+				{
+					const FTarget& Target = Targets[Index];
+					APawn* Pawn = Target.Pawn.Get();
+					if (!Pawn || Pawn == Querier || Pawn->IsHidden() ||
+						(TargetType == EALSFocusTargetType::Players && !Target.bIsPlayer) ||
+						(TargetType == EALSFocusTargetType::Characters && Target.bIsPlayer))
+					{
+						continue;
+					}
+
+					const float DistanceSquared = FVector::DistSquared(Origin, Target.Location);
+					if (DistanceSquared < BestDistanceSquared)
+					{
+						BestDistanceSquared = DistanceSquared;
+						BestPawn = Pawn;
+					}
+				}
+			}
+		}
+	}
+
+	return BestPawn;
+}
+
+FVector UALSTargetSubsystem::GetFocalPoint(const APawn* Pawn) const
+{
+	if (const int32* Index = TargetIndices.Find(Pawn))
+	{
+		return Targets[*Index].FocalPoint;
+	}
+	return Pawn->GetPawnViewLocation();
+}
+
+FIntPoint UALSTargetSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UALSTargetSubsystem::AddToCell(int32 TargetIndex)
+{
+	Cells.FindOrAdd(Targets[TargetIndex].Cell).Add(TargetIndex);
+}
+
+void UALSTargetSubsystem::RemoveFromCell(int32 TargetIndex)
+{
+	const FIntPoint Cell = Targets[TargetIndex].Cell;
+	if (TArray<int32>* CellTargets = Cells.Find(Cell))
+	{
+		CellTargets->RemoveSingleSwap(TargetIndex, false);
+		if (CellTargets->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UALSTargetSubsystem::RemoveTargetAt(int32 TargetIndex)
+{
+	RemoveFromCell(TargetIndex);
+	TargetIndices.Remove(Targets[TargetIndex].Pawn);
+
+	// Move the last target into the freed slot and fix up its references
+	const int32 LastIndex = Targets.Num() - 1;
+	if (TargetIndex != LastIndex)
+	{
+		if (TArray<int32>* CellTargets = Cells.Find(Targets[LastIndex].Cell))
+		{
+			CellTargets->Remove(LastIndex);
+			CellTargets->Add(TargetIndex);
+		}
+		TargetIndices.Add(Targets[LastIndex].Pawn, TargetIndex);
+	}
+
+	Targets.RemoveAtSwap(TargetIndex, 1, false);
+}
+
+void UALSTargetSubsystem::RegisterPlayerPawns()
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			RegisterTarget(PlayerController->GetPawn());
+		}
+	}
+}
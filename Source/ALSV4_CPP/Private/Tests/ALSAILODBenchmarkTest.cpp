@@ -0,0 +1,119 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AI/ALSAIController.h"
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
+
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSAILODBenchmarkTest, "ALS.Benchmark.AILOD",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+namespace ALSAILODBenchmark
+{
+	constexpr int32 NumAI = 500;
+
+	/* Shorter than the controller defaults, so the placement radius covers every tier*/
+	constexpr float MediumSignificanceDistance = 1000.0f;
+
+	constexpr float LowSignificanceDistance = 2000.0f;
+
+	struct FRunState
+	{
+		TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+		TArray<FString> Rows;
+		double AISeconds = 0.0;
+		double FrameSeconds = 0.0;
+		int32 Frames = 0;
+		int32 TierCounts[3] = {0, 0, 0};
+	};
+}
+
+bool FALSAILODBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSAILODBenchmark;
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	// Same placement with the LOD off, then on
+	const TSharedRef<FRunState> States[2] = {MakeShared<FRunState>(), MakeShared<FRunState>()};
+	for (int32 Run = 0; Run < 2; ++Run)
+	{
+		const bool bUseLOD = Run == 1;
+		const TSharedRef<FRunState> State = States[Run];
+		const FString Name = FString::Printf(TEXT("AILOD%d%s"), NumAI, bUseLOD ? TEXT("On") : TEXT("Off"));
+
+		ALSBenchmark::FRunSettings Settings;
+		Settings.Setup = [this, State, bUseLOD](UWorld* World)
+		{
+			State->Characters.Append(ALSBenchmark::SpawnAICharacters(*this, World, NumAI, 3000.0f));
+			for (const TWeakObjectPtr<AALSBaseCharacter>& Character : State->Characters)
+			{
+				if (AALSAIController* Controller = Cast<AALSAIController>(Character->GetController()))
+				{
+					Controller->MediumSignificanceDistance = MediumSignificanceDistance;
+					Controller->LowSignificanceDistance = LowSignificanceDistance;
+					Controller->SetUseSignificanceLOD(bUseLOD);
+				}
+			}
+			return State->Characters.Num() == NumAI;
+		};
+		Settings.OnFrame = [State](int32 Frame, double FrameSeconds)
+		{
+			const double AISeconds = ALSStageTimings::GetSeconds(EALSStage::AI);
+			State->AISeconds += AISeconds;
+			State->FrameSeconds += FrameSeconds;
+			State->Frames++;
+			State->Rows.Add(FString::Printf(TEXT("%d,%.4f,%.4f,%s"), Frame, FrameSeconds * 1000.0, AISeconds * 1000.0,
+			                                *ALSBenchmark::GetStageCsvValues()));
+		};
+		Settings.Finish = [this, State, States, Name, bUseLOD]()
+		{
+			for (const TWeakObjectPtr<AALSBaseCharacter>& Character : State->Characters)
+			{
+				if (const AALSAIController* Controller = Character.IsValid()
+					                                         ? Cast<AALSAIController>(Character->GetController())
+					                                         : nullptr)
+				{
+					State->TierCounts[static_cast<int32>(Controller->GetSignificanceTier())]++;
+				}
+			}
+			ALSBenchmark::DestroyCharacters(State->Characters);
+			if (State->Frames == 0)
+			{
+				return;
+			}
+
+			const FString FileName = ALSBenchmark::WriteCsv(
+				Name, TEXT("Frame,FrameMs,AIMs,") + ALSBenchmark::GetStageCsvHeader(), State->Rows);
+			AddInfo(FString::Printf(TEXT("%s timings written to %s, final tiers high %d, medium %d, low %d"), *Name,
+			                        *FileName, State->TierCounts[0], State->TierCounts[1], State->TierCounts[2]));
+
+			const double AIMs = State->AISeconds * 1000.0 / State->Frames;
+			ALSBenchmark::CheckBaseline(*this, Name + TEXT(".AIMs"), AIMs);
+
+			const TSharedRef<FRunState>& Off = States[0];
+			if (bUseLOD && Off->Frames > 0)
+			{
+				const double OffAIMs = Off->AISeconds * 1000.0 / Off->Frames;
+				AddInfo(FString::Printf(
+					TEXT("%d AI game thread AI time per frame: %.3f ms without the LOD, %.3f ms with it (%.1f%%). ")
+					TEXT("Frame time %.3f ms without, %.3f ms with"),
+					NumAI, OffAIMs, AIMs, OffAIMs > 0.0 ? AIMs * 100.0 / OffAIMs : 0.0,
+					Off->FrameSeconds * 1000.0 / Off->Frames, State->FrameSeconds * 1000.0 / State->Frames));
+			}
+		};
+
+		ADD_LATENT_AUTOMATION_COMMAND(ALSBenchmark::FRunCommand(*this, MoveTemp(Settings)));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,219 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Library/ALSLocomotionCore.h"
+#include "Library/ALSMathLibrary.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSBatchBenchmarkTest, "ALS.Benchmark.BatchKernels",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::PerfFilter)
+
+namespace ALSBatchBenchmark
+{
+	constexpr int32 NumCharacters = 1000;
+
+	constexpr int32 Iterations = 2000;
+
+	constexpr float DeltaTime = 1.0f / 30.0f;
+
+	constexpr float InterpSpeed = 4.0f;
+
+	/* Inputs of one batch, one element per character*/
+	struct FInputs
+	{
+		TArray<float> YawsA;
+		TArray<float> YawsB;
+		TArray<float> Angles;
+		TArray<float> VelocitiesX;
+		TArray<float> VelocitiesY;
+		TArray<float> VelocitiesZ;
+		TArray<float> AccelerationsX;
+		TArray<float> AccelerationsY;
+		TArray<float> MaxAccelerations;
+		TArray<EALSMovementDirection> Directions;
+
+		FInputs()
+		{
+			FRandomStream Random(NumCharacters);
+			for (int32 Index = 0; Index < NumCharacters; ++Index)
+			{
+				YawsA.Add(Random.FRandRange(-720.0f, 720.0f));
+				YawsB.Add(Random.FRandRange(-180.0f, 180.0f));
+				Angles.Add(Random.FRandRange(-180.0f, 180.0f));
+				VelocitiesX.Add(Random.FRandRange(-600.0f, 600.0f));
+				VelocitiesY.Add(Random.FRandRange(-600.0f, 600.0f));
+				VelocitiesZ.Add(Random.FRandRange(-50.0f, 50.0f));
+				AccelerationsX.Add(Random.FRandRange(-3000.0f, 3000.0f));
+				AccelerationsY.Add(Random.FRandRange(-3000.0f, 3000.0f));
+				MaxAccelerations.Add(Random.FRandRange(500.0f, 2000.0f));
+				Directions.Add(static_cast<EALSMovementDirection>(Random.RandRange(0, 3)));
+			}
+		}
+	};
+
+	/* Outputs of one batch, filled by both the scalar and the batch kernels*/
+	struct FOutputs
+	{
+		TArray<float> Deltas;
+		TArray<float> F;
+		TArray<float> B;
+		TArray<float> L;
+		TArray<float> R;
+		TArray<float> LeanLR;
+		TArray<float> LeanFB;
+		TArray<EALSMovementDirection> Directions;
+
+		explicit FOutputs(const FInputs& Inputs)
+		{
+			for (TArray<float>* Values : {&Deltas, &F, &B, &L, &R, &LeanLR, &LeanFB})
+			{
+				Values->SetNumZeroed(NumCharacters);
+			}
+			Directions = Inputs.Directions;
+		}
+	};
+
+	/* Per character versions, as the anim instance evaluates them*/
+	void RunScalar(const FInputs& In, FOutputs& Out, int32 Kernel)
+	{
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			const FRotator ActorRotation(0.0f, In.YawsA[Index], 0.0f);
+			switch (Kernel)
+			{
+			case 0:
+				Out.Deltas[Index] = FRotator::NormalizeAxis(In.YawsA[Index] - In.YawsB[Index]);
+				break;
+			case 1:
+				Out.Directions[Index] = UALSMathLibrary::CalculateQuadrant(
+					Out.Directions[Index], 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, In.Angles[Index]);
+				break;
+			case 2:
+				{
+					const FVector Velocity(In.VelocitiesX[Index], In.VelocitiesY[Index], In.VelocitiesZ[Index]);
+					const FVector Direction = ActorRotation.UnrotateVector(Velocity.GetSafeNormal(0.1f));
+					const ALSLocomotionCore::FVelocityBlend Blend =
+						ALSLocomotionCore::CalculateVelocityBlend(Direction.X, Direction.Y, Direction.Z);
+					Out.F[Index] = Blend.F;
+					Out.B[Index] = Blend.B;
+					Out.L[Index] = Blend.L;
+					Out.R[Index] = Blend.R;
+					break;
+				}
+			default:
+				{
+					const float MaxAcc = In.MaxAccelerations[Index];
+					const FVector Acceleration(In.AccelerationsX[Index], In.AccelerationsY[Index], 0.0f);
+					const FVector Relative = ActorRotation.UnrotateVector(
+						Acceleration.GetClampedToMaxSize(MaxAcc) / MaxAcc);
+					Out.LeanLR[Index] = FMath::FInterpTo(Out.LeanLR[Index], Relative.Y, DeltaTime, InterpSpeed);
+					Out.LeanFB[Index] = FMath::FInterpTo(Out.LeanFB[Index], Relative.X, DeltaTime, InterpSpeed);
+					break;
+				}
+			}
+		}
+	}
+
+	void RunBatch(const FInputs& In, FOutputs& Out, int32 Kernel)
+	{
+		switch (Kernel)
+		{
+		case 0:
+			UALSMathLibrary::CalculateYawDeltas(In.YawsA, In.YawsB, Out.Deltas);
+			break;
+		case 1:
+			UALSMathLibrary::CalculateQuadrants(Out.Directions, In.Angles, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f);
+			break;
+		case 2:
+			UALSMathLibrary::CalculateVelocityBlends(In.VelocitiesX, In.VelocitiesY, In.VelocitiesZ, In.YawsA,
+			                                         Out.F, Out.B, Out.L, Out.R);
+			break;
+		default:
+			UALSMathLibrary::InterpLeanAmounts(In.AccelerationsX, In.AccelerationsY, In.YawsA, In.MaxAccelerations,
+			                                   Out.LeanLR, Out.LeanFB, DeltaTime, InterpSpeed);
+			break;
+		}
+	}
+
+	static const TCHAR* KernelNames[] = {
+		TEXT("YawDeltas"), TEXT("Quadrants"), TEXT("VelocityBlends"), TEXT("LeanAmounts")
+	};
+
+	constexpr int32 NumKernels = UE_ARRAY_COUNT(KernelNames);
+
+	/* Microseconds per call over NumCharacters characters*/
+	template <typename RunFunc>
+	double Measure(RunFunc&& Run)
+	{
+		// One untimed call to warm up the caches
+		Run();
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Run();
+		}
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / Iterations;
+	}
+}
+
+bool FALSBatchBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSBatchBenchmark;
+
+	const FInputs Inputs;
+	TArray<FString> Rows;
+
+	for (int32 Kernel = 0; Kernel < NumKernels; ++Kernel)
+	{
+		FOutputs ScalarOutputs(Inputs);
+		FOutputs BatchOutputs(Inputs);
+
+		// Compare a single step first, lean amounts and quadrants depend on their previous values.
+		RunScalar(Inputs, ScalarOutputs, Kernel);
+		RunBatch(Inputs, BatchOutputs, Kernel);
+		int32 Mismatches = 0;
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			bool bMatches = ScalarOutputs.Directions[Index] == BatchOutputs.Directions[Index];
+			for (const TArray<float> FOutputs::* Values : {
+				     &FOutputs::Deltas, &FOutputs::F, &FOutputs::B, &FOutputs::L, &FOutputs::R, &FOutputs::LeanLR,
+				     &FOutputs::LeanFB
+			     })
+			{
+				bMatches &= FMath::IsNearlyEqual((ScalarOutputs.*Values)[Index], (BatchOutputs.*Values)[Index], 1.e-3f);
+			}
+			Mismatches += bMatches ? 0 : 1;
+		}
+		TestEqual(FString::Printf(TEXT("%s batch results differing from the scalar ones"), KernelNames[Kernel]),
+		          Mismatches, 0);
+
+		const double ScalarMicroseconds = Measure([&]() { RunScalar(Inputs, ScalarOutputs, Kernel); });
+		const double BatchMicroseconds = Measure([&]() { RunBatch(Inputs, BatchOutputs, Kernel); });
+
+		// Characters per second, in millions
+		const double ScalarThroughput = NumCharacters / ScalarMicroseconds;
+		const double BatchThroughput = NumCharacters / BatchMicroseconds;
+		AddInfo(FString::Printf(
+			TEXT("%s per 1k characters: scalar %.2f us (%.1f M/s), batch %.2f us (%.1f M/s), %.2fx"),
+			KernelNames[Kernel], ScalarMicroseconds, ScalarThroughput, BatchMicroseconds, BatchThroughput,
+			ScalarMicroseconds / FMath::Max(BatchMicroseconds, UE_DOUBLE_SMALL_NUMBER)));
+		Rows.Add(FString::Printf(TEXT("%s,%.3f,%.3f,%.2f,%.2f"), KernelNames[Kernel], ScalarMicroseconds,
+		                         BatchMicroseconds, ScalarThroughput, BatchThroughput));
+
+		ALSBenchmark::CheckBaseline(*this, FString::Printf(TEXT("BatchKernels.%s.Us"), KernelNames[Kernel]),
+		                            BatchMicroseconds);
+	}
+
+	const FString FileName = ALSBenchmark::WriteCsv(
+		TEXT("BatchKernels"), TEXT("Kernel,ScalarUsPer1k,BatchUsPer1k,ScalarMCharsPerSec,BatchMCharsPerSec"), Rows);
+	AddInfo(FString::Printf(TEXT("Kernel timings written to %s"), *FileName));
+	return true;
+}
+
+#endif
@@ -0,0 +1,340 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AI/ALSAIController.h"
+#include "Character/ALSCharacter.h"
+#include "Library/ALSStats.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "NavigationSystem.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace ALSBenchmark
+{
+	const TCHAR* DemoMapPath = TEXT("/ALSV4_CPP/AdvancedLocomotionV4/Levels/ALS_DemoLevel");
+
+	/* AI character of the demo content, driven by ALS_BT_AICharacter and ALS_BTTask_GetRandomLocation*/
+	static const TCHAR* DefaultCharacterClassPath =
+		TEXT("/ALSV4_CPP/AdvancedLocomotionV4/Blueprints/CharacterLogic/AI/ALS_AIBP.ALS_AIBP_C");
+
+	static float RegressionTolerance = 0.1f;
+	static FAutoConsoleVariableRef CVarRegressionTolerance(
+		TEXT("ALS.Benchmark.RegressionTolerance"), RegressionTolerance,
+		TEXT("Share a benchmark result may exceed its baseline by before the benchmark fails."));
+
+	UWorld* GetGameWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World())
+			{
+				return Context.World();
+			}
+		}
+		return nullptr;
+	}
+
+	UClass* LoadCharacterClass(FAutomationTestBase& Test)
+	{
+		FString ClassPath = DefaultCharacterClassPath;
+		FParse::Value(FCommandLine::Get(), TEXT("ALSBenchmarkCharacter="), ClassPath);
+		UClass* CharacterClass = StaticLoadClass(AALSCharacter::StaticClass(), nullptr, *ClassPath);
+		if (!CharacterClass)
+		{
+			Test.AddError(FString::Printf(TEXT("Failed to load ALS character class %s"), *ClassPath));
+			return nullptr;
+		}
+
+		const ACharacter* DefaultCharacter = CharacterClass->GetDefaultObject<ACharacter>();
+		if (!DefaultCharacter->AIControllerClass || !DefaultCharacter->AIControllerClass->IsChildOf<AALSAIController>())
+		{
+			Test.AddError(FString::Printf(TEXT("%s isn't controlled by an ALS AI controller"), *ClassPath));
+			return nullptr;
+		}
+		return CharacterClass;
+	}
+
+	TArray<AALSBaseCharacter*> SpawnAICharacters(FAutomationTestBase& Test, UWorld* World, int32 Count, float Radius)
+	{
+		TArray<AALSBaseCharacter*> Characters;
+
+		UClass* CharacterClass = LoadCharacterClass(Test);
+		if (!CharacterClass)
+		{
+			return Characters;
+		}
+		const ACharacter* DefaultCharacter = CharacterClass->GetDefaultObject<ACharacter>();
+
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		if (!NavSys)
+		{
+			Test.AddError(TEXT("Benchmark map has no navigation system"));
+			return Characters;
+		}
+
+		const APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0);
+		const FVector Center = Player ? Player->GetActorLocation() : FVector::ZeroVector;
+		const float HalfHeight = DefaultCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		// Same seed for the same count, so every run starts from the same placement
+		FRandomStream Random(Count);
+		for (int32 Attempt = 0; Characters.Num() < Count && Attempt < Count * 10; ++Attempt)
+		{
+			const FVector Candidate = Center + FVector(Random.FRandRange(-Radius, Radius),
+			                                           Random.FRandRange(-Radius, Radius), 0.0f);
+			FNavLocation NavLocation;
+			if (!NavSys->ProjectPointToNavigation(Candidate, NavLocation, FVector(100.0f, 100.0f, 1000.0f)))
+			{
+				continue;
+			}
+
+			const FRotator Rotation(0.0f, Random.FRandRange(-180.0f, 180.0f), 0.0f);
+			AALSBaseCharacter* Character = World->SpawnActor<AALSBaseCharacter>(
+				CharacterClass, NavLocation.Location + FVector(0.0f, 0.0f, HalfHeight), Rotation, SpawnParams);
+			if (!Character)
+			{
+				continue;
+			}
+
+			if (!Character->GetController())
+			{
+				Character->SpawnDefaultController();
+			}
+			Characters.Add(Character);
+		}
+
+		if (Characters.Num() < Count)
+		{
+			Test.AddError(FString::Printf(TEXT("Spawned %d of %d ALS characters"), Characters.Num(), Count));
+		}
+		return Characters;
+	}
+
+	void DestroyCharacters(TArray<TWeakObjectPtr<AALSBaseCharacter>>& Characters)
+	{
+		for (const TWeakObjectPtr<AALSBaseCharacter>& WeakCharacter : Characters)
+		{
+			AALSBaseCharacter* Character = WeakCharacter.Get();
+			if (!Character)
+			{
+				continue;
+			}
+
+			if (AController* Controller = Character->GetController())
+			{
+				Controller->Destroy();
+			}
+			Character->Destroy();
+		}
+		Characters.Reset();
+	}
+
+	FString WriteCsv(const FString& Name, const FString& Header, const TArray<FString>& Rows)
+	{
+		const FString FileName = FPaths::ProfilingDir() / TEXT("ALS") /
+			FString::Printf(TEXT("%s-%s.csv"), *Name, *FDateTime::Now().ToString());
+
+		FString Csv = Header + LINE_TERMINATOR;
+		for (const FString& Row : Rows)
+		{
+			Csv += Row + LINE_TERMINATOR;
+		}
+
+		return FFileHelper::SaveStringToFile(Csv, *FileName) ? FileName : FString();
+	}
+
+	static const TCHAR* StageNames[] = {
+		TEXT("CharacterTick"), TEXT("AnimUpdate"), TEXT("MovementComponent"), TEXT("Mantle"), TEXT("Footsteps"),
+		TEXT("AI"), TEXT("Ragdoll")
+	};
+	static_assert(UE_ARRAY_COUNT(StageNames) == static_cast<int32>(EALSStage::MAX), "Name every ALS stage");
+
+	FString GetStageCsvHeader()
+	{
+		FString Header;
+		for (int32 Stage = 0; Stage < static_cast<int32>(EALSStage::MAX); ++Stage)
+		{
+			Header += FString::Printf(TEXT("%s%sMs"), Stage > 0 ? TEXT(",") : TEXT(""), StageNames[Stage]);
+		}
+		return Header;
+	}
+
+	FString GetStageCsvValues()
+	{
+		FString Values;
+		for (int32 Stage = 0; Stage < static_cast<int32>(EALSStage::MAX); ++Stage)
+		{
+			Values += FString::Printf(TEXT("%s%.4f"), Stage > 0 ? TEXT(",") : TEXT(""),
+			                          ALSStageTimings::GetSeconds(static_cast<EALSStage>(Stage)) * 1000.0);
+		}
+		return Values;
+	}
+
+	/* Baselines depend on the machine, keep the stored one from the machine the benchmarks run on*/
+	static FString GetBaselineFile()
+	{
+		FString FileName;
+		if (FParse::Value(FCommandLine::Get(), TEXT("ALSBenchmarkBaseline="), FileName))
+		{
+			return FileName;
+		}
+
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("ALSV4_CPP"));
+		return Plugin ? Plugin->GetBaseDir() / TEXT("Resources/Benchmarks/ALSBenchmarkBaseline.json") : FString();
+	}
+
+	static TSharedRef<FJsonObject> LoadBaseline(const FString& FileName)
+	{
+		FString Json;
+		TSharedPtr<FJsonObject> Baseline;
+		if (FFileHelper::LoadFileToString(Json, *FileName))
+		{
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Baseline);
+		}
+		return Baseline.IsValid() ? Baseline.ToSharedRef() : MakeShared<FJsonObject>();
+	}
+
+	void CheckBaseline(FAutomationTestBase& Test, const FString& Key, double Value)
+	{
+		const FString FileName = GetBaselineFile();
+		const TSharedRef<FJsonObject> Baseline = LoadBaseline(FileName);
+
+		if (FParse::Param(FCommandLine::Get(), TEXT("ALSBenchmarkUpdateBaseline")))
+		{
+			Baseline->SetNumberField(Key, Value);
+
+			FString Json;
+			FJsonSerializer::Serialize(Baseline, TJsonWriterFactory<>::Create(&Json));
+			if (!FFileHelper::SaveStringToFile(Json, *FileName))
+			{
+				Test.AddError(FString::Printf(TEXT("Failed to write the benchmark baseline to %s"), *FileName));
+				return;
+			}
+			Test.AddInfo(FString::Printf(TEXT("%s: %.3f stored as the baseline"), *Key, Value));
+			return;
+		}
+
+		double BaselineValue = 0.0;
+		if (!Baseline->TryGetNumberField(Key, BaselineValue))
+		{
+			Test.AddError(FString::Printf(
+				TEXT("%s: %.3f, no baseline in %s. Run with -ALSBenchmarkUpdateBaseline to store it"),
+				*Key, Value, *FileName));
+			return;
+		}
+
+		const double Limit = BaselineValue * (1.0 + RegressionTolerance);
+		if (Value > Limit)
+		{
+			Test.AddError(FString::Printf(TEXT("%s regressed: %.3f, baseline %.3f, limit %.3f"),
+			                              *Key, Value, BaselineValue, Limit));
+			return;
+		}
+		Test.AddInfo(FString::Printf(TEXT("%s: %.3f, baseline %.3f"), *Key, Value, BaselineValue));
+	}
+
+	FRunCommand::FRunCommand(FAutomationTestBase& InTest, FRunSettings&& InSettings)
+		: Test(InTest), Settings(MoveTemp(InSettings))
+	{
+	}
+
+	FRunCommand::~FRunCommand()
+	{
+		// Restores the timestep if the test was aborted
+		End();
+	}
+
+	bool FRunCommand::Update()
+	{
+		const double Now = FPlatformTime::Seconds();
+
+		if (Frame == INDEX_NONE)
+		{
+			UWorld* World = GetGameWorld();
+			if (!World)
+			{
+				Test.AddError(TEXT("ALS benchmarks need a game world, run them with -game"));
+				bEnded = true;
+				return true;
+			}
+
+			bPrevUseFixedTimeStep = FApp::UseFixedTimeStep();
+			PrevFixedDeltaTime = FApp::GetFixedDeltaTime();
+			FApp::SetUseFixedTimeStep(true);
+			FApp::SetFixedDeltaTime(FixedDeltaTime);
+			Frame = 0;
+
+			if (Settings.Setup && !Settings.Setup(World))
+			{
+				End();
+				return true;
+			}
+
+			ALSStageTimings::Reset();
+			ALSStageTimings::bEnabled = true;
+			LastFrameTime = Now;
+			return false;
+		}
+
+		const double FrameSeconds = Now - LastFrameTime;
+		LastFrameTime = Now;
+
+		if (Frame >= Settings.WarmupFrames && Settings.OnFrame)
+		{
+			Settings.OnFrame(Frame - Settings.WarmupFrames, FrameSeconds);
+		}
+		ALSStageTimings::Reset();
+
+		if (++Frame >= Settings.WarmupFrames + Settings.MeasuredFrames)
+		{
+			End();
+			return true;
+		}
+		return false;
+	}
+
+	void FRunCommand::End()
+	{
+		if (bEnded)
+		{
+			return;
+		}
+		bEnded = true;
+
+		ALSStageTimings::bEnabled = false;
+		ALSStageTimings::Reset();
+
+		if (Frame != INDEX_NONE)
+		{
+			FApp::SetUseFixedTimeStep(bPrevUseFixedTimeStep);
+			FApp::SetFixedDeltaTime(PrevFixedDeltaTime);
+
+			if (Settings.Finish)
+			{
+				Settings.Finish();
+			}
+		}
+	}
+}
+
+#endif
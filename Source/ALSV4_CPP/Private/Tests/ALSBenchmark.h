@@ -0,0 +1,105 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+
+class AALSBaseCharacter;
+class UWorld;
+
+/**
+ * Shared setup of the ALS benchmark tests. The world benchmarks load the demo level and need a game world, run them
+ * headless with:
+ *
+ * UnrealEditor <Project> -game -nullrhi -nosound -unattended -ExecCmds="Automation RunTests ALS.Benchmark; Quit"
+ *
+ * Results are written to Saved/Profiling/ALS. -ALSBenchmarkUpdateBaseline stores the results as the new baseline,
+ * -ALSBenchmarkBaseline=<File> reads the baseline from another file.
+ */
+namespace ALSBenchmark
+{
+	extern const TCHAR* DemoMapPath;
+
+	/** Simulated frame length while benchmarking */
+	constexpr double FixedDeltaTime = 1.0 / 30.0;
+
+	UWorld* GetGameWorld();
+
+	/** AI driven ALS character class of the demo content, -ALSBenchmarkCharacter=<Class> replaces it */
+	UClass* LoadCharacterClass(FAutomationTestBase& Test);
+
+	/** Spawn AI driven ALS characters on the navmesh around the first player, placed the same on every run */
+	TArray<AALSBaseCharacter*> SpawnAICharacters(FAutomationTestBase& Test, UWorld* World, int32 Count, float Radius);
+
+	/** Destroy the characters still alive and their controllers */
+	void DestroyCharacters(TArray<TWeakObjectPtr<AALSBaseCharacter>>& Characters);
+
+	/** Write the rows to Saved/Profiling/ALS, returns the written file or an empty string */
+	FString WriteCsv(const FString& Name, const FString& Header, const TArray<FString>& Rows);
+
+	/** CSV columns of the ALS stage timings, in milliseconds */
+	FString GetStageCsvHeader();
+
+	/** ALS stage timings since the last reset, in the order of GetStageCsvHeader */
+	FString GetStageCsvValues();
+
+	/**
+	 * Compare the value to the stored baseline of the key, lower is better. Fails the test if the value exceeds the
+	 * baseline by more than ALS.Benchmark.RegressionTolerance, or if the key has no baseline. The stored crowd
+	 * baselines are the frame budgets of each crowd size, replace them with -ALSBenchmarkUpdateBaseline on the machine
+	 * the benchmarks run on.
+	 */
+	void CheckBaseline(FAutomationTestBase& Test, const FString& Key, double Value);
+
+	/** Settings of a benchmark run over several frames */
+	struct FRunSettings
+	{
+		int32 WarmupFrames = 60;
+
+		int32 MeasuredFrames = 600;
+
+		/** Called once the map is loaded, before the warmup. Returning false ends the run */
+		TFunction<bool(UWorld*)> Setup;
+
+		/** Called after each measured frame with the game thread time of the frame */
+		TFunction<void(int32 Frame, double FrameSeconds)> OnFrame;
+
+		/** Called after the last measured frame, or if the run ended early */
+		TFunction<void()> Finish;
+	};
+
+	/** Latent command running a benchmark with a fixed timestep and ALS stage timings enabled */
+	class FRunCommand : public IAutomationLatentCommand
+	{
+	public:
+		FRunCommand(FAutomationTestBase& InTest, FRunSettings&& InSettings);
+
+		virtual ~FRunCommand() override;
+
+		virtual bool Update() override;
+
+	private:
+		void End();
+
+		FAutomationTestBase& Test;
+
+		FRunSettings Settings;
+
+		int32 Frame = INDEX_NONE;
+
+		double LastFrameTime = 0.0;
+
+		bool bPrevUseFixedTimeStep = false;
+
+		double PrevFixedDeltaTime = 0.0;
+
+		bool bEnded = false;
+	};
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/ALSBaseCharacter.h"
+#include "Subsystems/ALSCharacterPoolSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSCharacterPoolBenchmarkTest, "ALS.Benchmark.CharacterPool",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+namespace ALSCharacterPoolBenchmark
+{
+	/* Kept at or below MaxPooledPerClass, so every released character stays pooled*/
+	constexpr int32 NumCharacters = 64;
+
+	constexpr float Spacing = 200.0f;
+
+	/* Grid around the first player, the same for the spawn and the reuse pass*/
+	static TArray<FTransform> GetTransforms(UWorld* World, const UClass* CharacterClass, int32 Count)
+	{
+		const APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0);
+		const FVector Center = Player ? Player->GetActorLocation() : FVector::ZeroVector;
+		const AALSBaseCharacter* DefaultCharacter = CharacterClass->GetDefaultObject<AALSBaseCharacter>();
+		const float HalfHeight = DefaultCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+
+		TArray<FTransform> Transforms;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FVector Offset((Index % Columns - Columns / 2) * Spacing, (Index / Columns - Columns / 2) * Spacing,
+			                     HalfHeight);
+			Transforms.Add(FTransform(Center + Offset));
+		}
+		return Transforms;
+	}
+}
+
+bool FALSCharacterPoolBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSCharacterPoolBenchmark;
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this]()
+	{
+		UWorld* World = ALSBenchmark::GetGameWorld();
+		UALSCharacterPoolSubsystem* Pool = World ? World->GetSubsystem<UALSCharacterPoolSubsystem>() : nullptr;
+		if (!Pool)
+		{
+			AddError(TEXT("ALS benchmarks need a game world, run them with -game"));
+			return true;
+		}
+
+		UClass* CharacterClass = ALSBenchmark::LoadCharacterClass(*this);
+		if (!CharacterClass)
+		{
+			return true;
+		}
+		if (Pool->GetNumPooled(CharacterClass) > 0)
+		{
+			AddError(TEXT("Character pool benchmark needs an empty pool, the map already released characters"));
+			return true;
+		}
+
+		const int32 Count = FMath::Min(NumCharacters, Pool->MaxPooledPerClass);
+		const TArray<FTransform> Transforms = GetTransforms(World, CharacterClass, Count);
+		const FALSCharacterPoolStats StartStats = Pool->GetPoolStats();
+
+		// Empty pool, every character is spawned
+		TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+		TArray<double> SpawnSeconds;
+		for (const FTransform& Transform : Transforms)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Characters.Add(Pool->AcquireCharacter(CharacterClass, Transform));
+			SpawnSeconds.Add(FPlatformTime::Seconds() - StartTime);
+		}
+
+		for (const TWeakObjectPtr<AALSBaseCharacter>& Character : Characters)
+		{
+			Pool->ReleaseCharacter(Character.Get());
+		}
+		Characters.Reset();
+
+		// Same transforms again, every character comes from the pool
+		TArray<double> ReuseSeconds;
+		for (const FTransform& Transform : Transforms)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Characters.Add(Pool->AcquireCharacter(CharacterClass, Transform));
+			ReuseSeconds.Add(FPlatformTime::Seconds() - StartTime);
+		}
+
+		const FALSCharacterPoolStats EndStats = Pool->GetPoolStats();
+		ALSBenchmark::DestroyCharacters(Characters);
+
+		TArray<FString> Rows;
+		double TotalSpawnSeconds = 0.0;
+		double TotalReuseSeconds = 0.0;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			TotalSpawnSeconds += SpawnSeconds[Index];
+			TotalReuseSeconds += ReuseSeconds[Index];
+			Rows.Add(FString::Printf(TEXT("%d,%.4f,%.4f"), Index, SpawnSeconds[Index] * 1000.0,
+			                         ReuseSeconds[Index] * 1000.0));
+		}
+
+		const FString FileName = ALSBenchmark::WriteCsv(TEXT("CharacterPool"), TEXT("Character,SpawnMs,ReuseMs"),
+		                                                Rows);
+		AddInfo(FString::Printf(TEXT("Character pool timings written to %s"), *FileName));
+
+		if (EndStats.Spawned - StartStats.Spawned != Count || EndStats.Reused - StartStats.Reused != Count)
+		{
+			AddError(FString::Printf(TEXT("Expected %d spawned and %d reused characters, got %d spawned and %d reused"),
+			                         Count, Count, EndStats.Spawned - StartStats.Spawned,
+			                         EndStats.Reused - StartStats.Reused));
+			return true;
+		}
+
+		const double SpawnMs = TotalSpawnSeconds * 1000.0 / Count;
+		const double ReuseMs = TotalReuseSeconds * 1000.0 / Count;
+		AddInfo(FString::Printf(TEXT("%d characters, per character: %.3f ms spawned, %.3f ms reused (%.1f%%)"),
+		                        Count, SpawnMs, ReuseMs, SpawnMs > 0.0 ? ReuseMs * 100.0 / SpawnMs : 0.0));
+		if (ReuseMs > SpawnMs)
+		{
+			AddError(FString::Printf(TEXT("Reusing a pooled character (%.3f ms) is slower than spawning it (%.3f ms)"),
+			                         ReuseMs, SpawnMs));
+		}
+		return true;
+	}));
+
+	return true;
+}
+
+#endif
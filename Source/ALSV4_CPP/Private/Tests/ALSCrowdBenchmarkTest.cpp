@@ -0,0 +1,75 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
+
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FALSCrowdBenchmarkTest, "ALS.Benchmark.Crowd",
+                                  EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+void FALSCrowdBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const TCHAR* Count : {TEXT("50"), TEXT("200"), TEXT("500")})
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%s Characters"), Count));
+		OutTestCommands.Add(Count);
+	}
+}
+
+bool FALSCrowdBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const int32 Count = FCString::Atoi(*Parameters);
+
+	struct FState
+	{
+		TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+		TArray<FString> Rows;
+		double FrameSeconds = 0.0;
+		int32 Frames = 0;
+	};
+	const TSharedRef<FState> State = MakeShared<FState>();
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	ALSBenchmark::FRunSettings Settings;
+	Settings.Setup = [this, State, Count](UWorld* World)
+	{
+		State->Characters.Append(ALSBenchmark::SpawnAICharacters(*this, World, Count, 3000.0f));
+		return State->Characters.Num() == Count;
+	};
+	Settings.OnFrame = [State](int32 Frame, double FrameSeconds)
+	{
+		State->FrameSeconds += FrameSeconds;
+		State->Frames++;
+		State->Rows.Add(FString::Printf(TEXT("%d,%.4f,%s"), Frame, FrameSeconds * 1000.0,
+		                                *ALSBenchmark::GetStageCsvValues()));
+	};
+	Settings.Finish = [this, State, Count]()
+	{
+		ALSBenchmark::DestroyCharacters(State->Characters);
+		if (State->Frames == 0)
+		{
+			return;
+		}
+
+		const FString Name = FString::Printf(TEXT("Crowd%d"), Count);
+		const FString FileName = ALSBenchmark::WriteCsv(Name, TEXT("Frame,FrameMs,") + ALSBenchmark::GetStageCsvHeader(),
+		                                                State->Rows);
+		AddInfo(FString::Printf(TEXT("Stage timings written to %s"), *FileName));
+
+		ALSBenchmark::CheckBaseline(*this, FString::Printf(TEXT("%s.FrameMs"), *Name),
+		                            State->FrameSeconds * 1000.0 / State->Frames);
+	};
+
+	ADD_LATENT_AUTOMATION_COMMAND(ALSBenchmark::FRunCommand(*this, MoveTemp(Settings)));
+	return true;
+}
+
+#endif
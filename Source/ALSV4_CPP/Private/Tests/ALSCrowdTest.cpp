@@ -0,0 +1,251 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSLocomotionCore.h"
+#include "Library/ALSMovementModelCache.h"
+#include "Mass/ALSCrowdFragments.h"
+#include "Subsystems/ALSCrowdSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "MassEntitySubsystem.h"
+#include "Misc/ScopeExit.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSCrowdTest, "ALS.Crowd.Headless",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext |
+                                 EAutomationTestFlags::ProductFilter)
+
+namespace ALSCrowdTest
+{
+	constexpr int32 NumAgents = 54;
+
+	constexpr int32 NumSteps = 60;
+
+	/* Agent values before a simulation step, the expected results are computed from them*/
+	struct FAgentSnapshot
+	{
+		float Yaw = 0.0f;
+		float TargetYaw = 0.0f;
+		float Speed = 0.0f;
+	};
+
+	/* Same gait rules as AALSBaseCharacter::GetAllowedGait and GetActualGait*/
+	static EALSGait GetExpectedGait(const FALSCrowdMovementFragment& Movement, const FALSCrowdStateFragment& State,
+	                                const FALSMovementSettings& Settings, float SpeedBefore)
+	{
+		const FVector Input = Movement.MovementInput.GetClampedToMaxSize2D(1.0f);
+		const float InputAimYawDelta = State.RotationMode == EALSRotationMode::LookingDirection
+			                               ? ALSLocomotionCore::NormalizeAxis(Input.Rotation().Yaw - Movement.AimYaw)
+			                               : 0.0f;
+		const ALSLocomotionCore::ERotationMode RotationMode =
+			static_cast<ALSLocomotionCore::ERotationMode>(State.RotationMode);
+
+		const bool bCanSprint = State.DesiredGait == EALSGait::Sprinting &&
+			ALSLocomotionCore::CanSprint(Input.Size2D() > 0.0f, Input.Size2D(), RotationMode, InputAimYawDelta);
+		const ALSLocomotionCore::EGait AllowedGait = ALSLocomotionCore::GetAllowedGait(
+			static_cast<ALSLocomotionCore::EStance>(State.Stance), RotationMode,
+			static_cast<ALSLocomotionCore::EGait>(State.DesiredGait), bCanSprint);
+		return static_cast<EALSGait>(ALSLocomotionCore::GetActualGait(AllowedGait, SpeedBefore, Settings.WalkSpeed,
+		                                                              Settings.RunSpeed));
+	}
+
+	/* Same rotation as AALSBaseCharacter::SmoothCharacterRotation while grounded, without the aim yaw rate*/
+	static float GetExpectedYaw(const FALSCrowdMovementFragment& Movement, const FALSCrowdStateFragment& State,
+	                            const FALSMovementSettings& Settings, const FAgentSnapshot& Before, float DeltaTime)
+	{
+		const bool bHasMovementInput = !Movement.MovementInput.IsNearlyZero();
+		if (!((Movement.Speed > 1.0f && bHasMovementInput) || Movement.Speed > 150.0f))
+		{
+			return Before.Yaw;
+		}
+
+		const float MappedSpeed = ALSLocomotionCore::GetMappedSpeed(Movement.Speed, Settings.WalkSpeed,
+		                                                            Settings.RunSpeed, Settings.SprintSpeed);
+		const float CurveValue = Settings.RotationRateCurve
+			                         ? Settings.RotationRateCurve->GetFloatValue(MappedSpeed)
+			                         : 10.0f;
+		float ActorInterpSpeed = ALSLocomotionCore::CalculateGroundedRotationRate(CurveValue, 0.0f);
+
+		float GoalYaw = Movement.AimYaw;
+		float TargetInterpSpeed = 1000.0f;
+		if (State.RotationMode == EALSRotationMode::VelocityDirection)
+		{
+			GoalYaw = Movement.LastVelocityYaw;
+			TargetInterpSpeed = 800.0f;
+		}
+		else if (State.RotationMode == EALSRotationMode::LookingDirection)
+		{
+			GoalYaw = State.Gait == EALSGait::Sprinting ? Movement.LastVelocityYaw : Movement.AimYaw;
+			TargetInterpSpeed = 500.0f;
+		}
+		else
+		{
+			ActorInterpSpeed = 20.0f;
+		}
+
+		const FRotator Target = FMath::RInterpConstantTo(FRotator(0.0f, Before.TargetYaw, 0.0f),
+		                                                 FRotator(0.0f, GoalYaw, 0.0f), DeltaTime, TargetInterpSpeed);
+		return FMath::RInterpTo(FRotator(0.0f, Before.Yaw, 0.0f), Target, DeltaTime, ActorInterpSpeed).Yaw;
+	}
+}
+
+bool FALSCrowdTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSCrowdTest;
+
+	UClass* CharacterClass = ALSBenchmark::LoadCharacterClass(*this);
+	if (!CharacterClass)
+	{
+		return false;
+	}
+
+	// Own game world without player controllers, nothing views the crowd
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ALSCrowdTest"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	ON_SCOPE_EXIT
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	};
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// Floor for the hydrated characters, its top is at zero height
+	AStaticMeshActor* Floor = World->SpawnActor<AStaticMeshActor>(FVector(0.0f, 0.0f, -50.0f), FRotator::ZeroRotator);
+	Floor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Floor->GetStaticMeshComponent()->SetStaticMesh(
+		LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+	Floor->SetActorScale3D(FVector(100.0f, 100.0f, 1.0f));
+
+	UALSCrowdSubsystem* Crowd = World->GetSubsystem<UALSCrowdSubsystem>();
+	UMassEntitySubsystem* EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+	if (!TestNotNull(TEXT("Crowd subsystem"), Crowd) || !TestNotNull(TEXT("Mass entity subsystem"), EntitySubsystem))
+	{
+		return false;
+	}
+	Crowd->bAutoSimulate = false;
+	Crowd->bEnableHydration = false;
+	const FMassEntityManager& EntityManager = EntitySubsystem->GetEntityManager();
+
+	const float HalfHeight = CharacterClass->GetDefaultObject<AALSBaseCharacter>()->GetCapsuleComponent()->
+	                                         GetScaledCapsuleHalfHeight();
+	TArray<FTransform> Transforms;
+	for (int32 Index = 0; Index < NumAgents; ++Index)
+	{
+		Transforms.Emplace(FRotator(0.0f, Index * 37.0f, 0.0f),
+		                   FVector(Index % 9 * 300.0f, Index / 9 * 300.0f, HalfHeight + 2.0f));
+	}
+	if (!TestEqual(TEXT("Spawned agents"), Crowd->SpawnCrowd(CharacterClass, Transforms), NumAgents))
+	{
+		return false;
+	}
+
+	// Every combination of desired gait, rotation mode and stance, with mixed input amounts and aim directions
+	const TArray<FMassEntityHandle> Agents = Crowd->GetAgents();
+	FRandomStream Random(NumAgents);
+	for (int32 Index = 0; Index < Agents.Num(); ++Index)
+	{
+		const float InputYaw = FMath::DegreesToRadians(Random.FRandRange(-180.0f, 180.0f));
+		const float InputAmount = Index % 4 == 3 ? 0.5f : 1.0f;
+		Crowd->SetAgentMovementInput(Agents[Index], FVector(FMath::Cos(InputYaw), FMath::Sin(InputYaw), 0.0f) *
+		                             InputAmount, Random.FRandRange(-180.0f, 180.0f),
+		                             static_cast<EALSGait>(Index % 3));
+		Crowd->SetAgentStates(Agents[Index], static_cast<EALSStance>(Index / 9 % 2),
+		                      static_cast<EALSRotationMode>(Index / 3 % 3),
+		                      static_cast<EALSOverlayState>(Index % (static_cast<int32>(EALSOverlayState::Barrel) + 1)));
+	}
+
+	int32 NumGaitMismatches = 0;
+	int32 NumYawMismatches = 0;
+	TArray<FAgentSnapshot> Snapshots;
+	Snapshots.SetNum(Agents.Num());
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		for (int32 Index = 0; Index < Agents.Num(); ++Index)
+		{
+			const FALSCrowdTransformFragment& Transform =
+				EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agents[Index]);
+			Snapshots[Index].Yaw = Transform.Yaw;
+			Snapshots[Index].TargetYaw = Transform.TargetYaw;
+			Snapshots[Index].Speed = EntityManager.GetFragmentDataChecked<FALSCrowdMovementFragment>(Agents[Index]).Speed;
+		}
+
+		Crowd->Simulate(ALSBenchmark::FixedDeltaTime);
+
+		for (int32 Index = 0; Index < Agents.Num(); ++Index)
+		{
+			const FALSCrowdMovementFragment& Movement =
+				EntityManager.GetFragmentDataChecked<FALSCrowdMovementFragment>(Agents[Index]);
+			const FALSCrowdStateFragment& State =
+				EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agents[Index]);
+			const FALSCrowdAgentFragment& AgentData =
+				EntityManager.GetFragmentDataChecked<FALSCrowdAgentFragment>(Agents[Index]);
+			const FALSMovementSettings& Settings = AgentData.MovementModel->GetSettings(
+				FALSMovementModel::GetSettingsIndex(State.RotationMode, State.Stance));
+
+			if (State.Gait != GetExpectedGait(Movement, State, Settings, Snapshots[Index].Speed) &&
+				NumGaitMismatches++ == 0)
+			{
+				AddError(FString::Printf(TEXT("Agent %d gait differs from the character rules at step %d"), Index,
+				                         Step));
+			}
+
+			const float ExpectedYaw = GetExpectedYaw(Movement, State, Settings, Snapshots[Index],
+			                                         ALSBenchmark::FixedDeltaTime);
+			const float Yaw = EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agents[Index]).Yaw;
+			if (!FMath::IsNearlyZero(FRotator::NormalizeAxis(Yaw - ExpectedYaw), 0.01f) && NumYawMismatches++ == 0)
+			{
+				AddError(FString::Printf(TEXT("Agent %d yaw %.3f, character rotation gives %.3f at step %d"), Index,
+				                         Yaw, ExpectedYaw, Step));
+			}
+		}
+	}
+	TestEqual(TEXT("Gait mismatches"), NumGaitMismatches, 0);
+	TestEqual(TEXT("Yaw mismatches"), NumYawMismatches, 0);
+
+	// Hydrating and dehydrating an agent keeps its state
+	for (const int32 Index : {0, 13, 40})
+	{
+		const FMassEntityHandle Agent = Agents[Index];
+		Crowd->SetAgentMovementInput(Agent, FVector::ZeroVector, 0.0f, EALSGait::Walking);
+
+		const FALSCrowdTransformFragment TransformBefore =
+			EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agent);
+		const FALSCrowdStateFragment StateBefore = EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent);
+
+		if (!TestTrue(FString::Printf(TEXT("Agent %d hydrated"), Index), Crowd->HydrateAgent(Agent)) ||
+			!TestNotNull(FString::Printf(TEXT("Agent %d character"), Index), Crowd->GetAgentActor(Agent)) ||
+			!TestTrue(FString::Printf(TEXT("Agent %d dehydrated"), Index), Crowd->DehydrateAgent(Agent)))
+		{
+			continue;
+		}
+
+		const FALSCrowdTransformFragment& Transform =
+			EntityManager.GetFragmentDataChecked<FALSCrowdTransformFragment>(Agent);
+		const FALSCrowdStateFragment& State = EntityManager.GetFragmentDataChecked<FALSCrowdStateFragment>(Agent);
+		TestNull(FString::Printf(TEXT("Agent %d character after dehydration"), Index), Crowd->GetAgentActor(Agent));
+		TestEqual(FString::Printf(TEXT("Agent %d gait"), Index), State.Gait, StateBefore.Gait);
+		TestEqual(FString::Printf(TEXT("Agent %d stance"), Index), State.Stance, StateBefore.Stance);
+		TestEqual(FString::Printf(TEXT("Agent %d rotation mode"), Index), State.RotationMode, StateBefore.RotationMode);
+		TestEqual(FString::Printf(TEXT("Agent %d overlay state"), Index), State.OverlayState, StateBefore.OverlayState);
+		TestTrue(FString::Printf(TEXT("Agent %d location"), Index),
+		         Transform.Location.Equals(TransformBefore.Location, 1.0f));
+		TestTrue(FString::Printf(TEXT("Agent %d yaw"), Index),
+		         FMath::IsNearlyZero(FRotator::NormalizeAxis(Transform.Yaw - TransformBefore.Yaw), 0.1f));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/ALSBaseCharacter.h"
+#include "Subsystems/ALSSceneQuerySubsystem.h"
+
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSGroundProbeBenchmarkTest, "ALS.Benchmark.GroundProbes",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FALSGroundProbeBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Count = 200;
+
+	struct FState
+	{
+		TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+		TWeakObjectPtr<UALSSceneQuerySubsystem> Subsystem;
+		FALSSceneQueryStats LastStats;
+		TArray<FString> Rows;
+		int64 Probes = 0;
+		int64 SharedProbes = 0;
+		int32 Frames = 0;
+	};
+	const TSharedRef<FState> State = MakeShared<FState>();
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	ALSBenchmark::FRunSettings Settings;
+	Settings.Setup = [this, State](UWorld* World)
+	{
+		State->Subsystem = World->GetSubsystem<UALSSceneQuerySubsystem>();
+		if (!State->Subsystem.IsValid())
+		{
+			AddError(TEXT("Benchmark world has no ALS scene query subsystem"));
+			return false;
+		}
+
+		State->Characters.Append(ALSBenchmark::SpawnAICharacters(*this, World, Count, 3000.0f));
+		State->LastStats = State->Subsystem->GetTotalStats();
+		return State->Characters.Num() == Count;
+	};
+	Settings.OnFrame = [State](int32 Frame, double FrameSeconds)
+	{
+		if (!State->Subsystem.IsValid())
+		{
+			return;
+		}
+
+		// Frame stats are reset by the first query of a frame, the difference of the totals doesn't depend on when
+		// the latent command runs in the frame.
+		const FALSSceneQueryStats Stats = State->Subsystem->GetTotalStats();
+		const int32 Probes = Stats.GroundProbes - State->LastStats.GroundProbes;
+		const int32 SharedProbes = Stats.GroundProbesShared - State->LastStats.GroundProbesShared;
+		const int32 Executed = Stats.Executed - State->LastStats.Executed;
+		State->LastStats = Stats;
+
+		State->Probes += Probes;
+		State->SharedProbes += SharedProbes;
+		State->Frames++;
+		State->Rows.Add(FString::Printf(TEXT("%d,%.4f,%d,%d,%d,%d"), Frame, FrameSeconds * 1000.0, Probes,
+		                                SharedProbes, Probes - SharedProbes, Executed));
+	};
+	Settings.Finish = [this, State]()
+	{
+		ALSBenchmark::DestroyCharacters(State->Characters);
+		if (State->Frames == 0)
+		{
+			return;
+		}
+
+		const FString Name = FString::Printf(TEXT("GroundProbes%d"), Count);
+		const FString FileName = ALSBenchmark::WriteCsv(
+			Name, TEXT("Frame,FrameMs,GroundProbes,SharedGroundProbes,GroundTraces,ExecutedQueries"), State->Rows);
+		AddInfo(FString::Printf(TEXT("Ground probe counters written to %s"), *FileName));
+
+		AddInfo(FString::Printf(TEXT("%lld ground probes, %lld traces saved by sharing (%.1f%%), %.1f saved per frame"),
+		                        State->Probes, State->SharedProbes,
+		                        State->Probes > 0 ? State->SharedProbes * 100.0 / State->Probes : 0.0,
+		                        static_cast<double>(State->SharedProbes) / State->Frames));
+
+		ALSBenchmark::CheckBaseline(*this, FString::Printf(TEXT("%s.GroundTracesPerFrame"), *Name),
+		                            static_cast<double>(State->Probes - State->SharedProbes) / State->Frames);
+	};
+
+	ADD_LATENT_AUTOMATION_COMMAND(ALSBenchmark::FRunCommand(*this, MoveTemp(Settings)));
+	return true;
+}
+
+#endif
@@ -0,0 +1,197 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Subsystems/ALSNavQuerySubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSNavQueryBenchmarkTest, "ALS.Benchmark.NavQueries",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+namespace ALSNavQueryBenchmark
+{
+	constexpr int32 NumAgents = 500;
+
+	/* Every agent repicks its destination once per round*/
+	constexpr int32 NumRounds = 5;
+
+	/* MaxDistance of the ALS_BT_AICharacter random location task*/
+	constexpr float QueryRadius = 1000.0f;
+
+	constexpr float SpawnRadius = 3000.0f;
+
+	struct FRoundResult
+	{
+		double TotalMs = 0.0;
+		double MaxFrameMs = 0.0;
+		int32 Frames = 0;
+		int32 Found = 0;
+		int32 Pooled = 0;
+	};
+
+	/* Previous task behavior: resolve the filter and query on the game thread, all agents in the same frame*/
+	FRoundResult RunSync(UWorld* World, UNavigationSystemV1& NavSys, const ANavigationData& NavData,
+	                     TSubclassOf<UNavigationQueryFilter> Filter, const TArray<FVector>& Origins)
+	{
+		FRoundResult Result;
+		const double StartTime = FPlatformTime::Seconds();
+		for (const FVector& Origin : Origins)
+		{
+			FNavLocation Destination;
+			const FSharedConstNavQueryFilter SharedFilter = UNavigationQueryFilter::GetQueryFilter(NavData, World, Filter);
+			Result.Found += NavSys.GetRandomReachablePointInRadius(Origin, QueryRadius, Destination, &NavData,
+			                                                       SharedFilter) ? 1 : 0;
+		}
+		Result.TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		Result.MaxFrameMs = Result.TotalMs;
+		Result.Frames = 1;
+		return Result;
+	}
+
+	/* Current task behavior: draw from the point pool, otherwise queue the query within the subsystem budget*/
+	FRoundResult RunSubsystem(UALSNavQuerySubsystem& Subsystem, TSubclassOf<UNavigationQueryFilter> Filter,
+	                          const TArray<FVector>& Origins)
+	{
+		FRoundResult Result;
+		int32 Pending = 0;
+
+		double FrameStartTime = FPlatformTime::Seconds();
+		for (const FVector& Origin : Origins)
+		{
+			FVector Destination;
+			if (Subsystem.TryGetPooledPoint(Origin, QueryRadius, Filter, Destination))
+			{
+				Result.Found++;
+				Result.Pooled++;
+				continue;
+			}
+
+			Pending++;
+			Subsystem.RequestRandomReachablePoint(
+				Origin, QueryRadius, Filter, true,
+				FALSRandomLocationDelegate::CreateLambda([&Result, &Pending](bool bSuccess, const FVector&)
+				{
+					Result.Found += bSuccess ? 1 : 0;
+					Pending--;
+				}));
+		}
+
+		// Each tick is one frame of the subsystem budget, the requests are queued in the first one
+		do
+		{
+			Subsystem.Tick(ALSBenchmark::FixedDeltaTime);
+
+			const double Now = FPlatformTime::Seconds();
+			const double FrameMs = (Now - FrameStartTime) * 1000.0;
+			FrameStartTime = Now;
+
+			Result.TotalMs += FrameMs;
+			Result.MaxFrameMs = FMath::Max(Result.MaxFrameMs, FrameMs);
+			Result.Frames++;
+		}
+		while (Pending > 0);
+
+		return Result;
+	}
+}
+
+bool FALSNavQueryBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSNavQueryBenchmark;
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this]()
+	{
+		UWorld* World = ALSBenchmark::GetGameWorld();
+		UNavigationSystemV1* NavSys = World ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+		const ANavigationData* NavData = NavSys
+			                                 ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)
+			                                 : nullptr;
+		UALSNavQuerySubsystem* Subsystem = World ? World->GetSubsystem<UALSNavQuerySubsystem>() : nullptr;
+		if (!NavData || !Subsystem)
+		{
+			AddError(TEXT("Nav query benchmark needs a game world with a nav mesh and the ALS nav query subsystem"));
+			return true;
+		}
+
+		// Agent positions on the nav mesh around the player, the same on every run
+		const APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0);
+		const FVector Center = Player ? Player->GetActorLocation() : FVector::ZeroVector;
+		FRandomStream Random(NumAgents);
+		TArray<FVector> Origins;
+		for (int32 Attempt = 0; Origins.Num() < NumAgents && Attempt < NumAgents * 10; ++Attempt)
+		{
+			const FVector Candidate = Center + FVector(Random.FRandRange(-SpawnRadius, SpawnRadius),
+			                                           Random.FRandRange(-SpawnRadius, SpawnRadius), 0.0f);
+			FNavLocation NavLocation;
+			if (NavSys->ProjectPointToNavigation(Candidate, NavLocation, FVector(100.0f, 100.0f, 1000.0f)))
+			{
+				Origins.Add(NavLocation.Location);
+			}
+		}
+		if (!TestEqual(TEXT("Agents placed on the nav mesh"), Origins.Num(), NumAgents))
+		{
+			return true;
+		}
+
+		// Serve the requests of AI already in the level, so they don't count into the measured frames
+		while (Subsystem->GetNumPendingRequests() > 0)
+		{
+			Subsystem->Tick(ALSBenchmark::FixedDeltaTime);
+		}
+
+		const TSubclassOf<UNavigationQueryFilter> Filter = UNavigationQueryFilter::StaticClass();
+		TArray<FString> Rows;
+		FRoundResult SyncTotal;
+		FRoundResult SubsystemTotal;
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			const FRoundResult Sync = RunSync(World, *NavSys, *NavData, Filter, Origins);
+			const FRoundResult Async = RunSubsystem(*Subsystem, Filter, Origins);
+
+			for (const TPair<const TCHAR*, const FRoundResult*>& Mode : {
+				     TPair<const TCHAR*, const FRoundResult*>(TEXT("Sync"), &Sync),
+				     TPair<const TCHAR*, const FRoundResult*>(TEXT("Subsystem"), &Async)
+			     })
+			{
+				Rows.Add(FString::Printf(TEXT("%s,%d,%.4f,%.4f,%d,%d,%d"), Mode.Key, Round, Mode.Value->TotalMs,
+				                         Mode.Value->MaxFrameMs, Mode.Value->Frames, Mode.Value->Found,
+				                         Mode.Value->Pooled));
+			}
+
+			SyncTotal.TotalMs += Sync.TotalMs;
+			SyncTotal.MaxFrameMs = FMath::Max(SyncTotal.MaxFrameMs, Sync.MaxFrameMs);
+			SubsystemTotal.TotalMs += Async.TotalMs;
+			SubsystemTotal.MaxFrameMs = FMath::Max(SubsystemTotal.MaxFrameMs, Async.MaxFrameMs);
+			SubsystemTotal.Frames += Async.Frames;
+			SubsystemTotal.Pooled += Async.Pooled;
+		}
+
+		const FString FileName = ALSBenchmark::WriteCsv(FString::Printf(TEXT("NavQueries%d"), NumAgents),
+		                                                TEXT("Mode,Round,TotalMs,MaxFrameMs,Frames,Found,Pooled"), Rows);
+		AddInfo(FString::Printf(TEXT("Nav query timings written to %s"), *FileName));
+
+		AddInfo(FString::Printf(
+			TEXT("%d agents repicking %d times. Sync: %.2f ms total, %.2f ms worst frame. Subsystem: %.2f ms total, ")
+			TEXT("%.2f ms worst frame, spread over %d frames, %d of %d destinations from the point pool"),
+			NumAgents, NumRounds, SyncTotal.TotalMs, SyncTotal.MaxFrameMs, SubsystemTotal.TotalMs,
+			SubsystemTotal.MaxFrameMs, SubsystemTotal.Frames, SubsystemTotal.Pooled, NumAgents * NumRounds));
+
+		ALSBenchmark::CheckBaseline(*this, FString::Printf(TEXT("NavQueries%d.MaxFrameMs"), NumAgents),
+		                            SubsystemTotal.MaxFrameMs);
+		return true;
+	}));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,150 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/ALSCharacter.h"
+#include "Character/ALSOverlayAssets.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "EngineUtils.h"
+#include "Misc/CommandLine.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSOverlayMemoryBenchmarkTest, "ALS.Benchmark.OverlayMemory",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+namespace ALSOverlayMemoryBenchmark
+{
+	/* Held object assets of the overlay states, once each*/
+	static void GetAssetsToLoad(const UALSOverlayAssets& OverlayAssets, const TArray<EALSOverlayState>& OverlayStates,
+	                            TArray<FSoftObjectPath>& OutAssets)
+	{
+		for (const EALSOverlayState OverlayState : OverlayStates)
+		{
+			if (const FALSHeldObjectSettings* Settings = OverlayAssets.HeldObjects.Find(OverlayState))
+			{
+				TArray<FSoftObjectPath> Assets;
+				Settings->GetAssetsToLoad(Assets);
+				for (const FSoftObjectPath& Asset : Assets)
+				{
+					OutAssets.AddUnique(Asset);
+				}
+			}
+		}
+	}
+
+	static int64 GetLoadedBytes(const TArray<FSoftObjectPath>& Paths)
+	{
+		int64 Bytes = 0;
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			if (const UObject* Object = Path.ResolveObject())
+			{
+				Bytes += Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			}
+		}
+		return Bytes;
+	}
+
+	/* -ALSOverlayAssets=<Path> if given, otherwise the overlay assets of the first ALS character in the world*/
+	static UALSOverlayAssets* FindOverlayAssets(UWorld* World)
+	{
+		FString Path;
+		if (FParse::Value(FCommandLine::Get(), TEXT("ALSOverlayAssets="), Path))
+		{
+			return LoadObject<UALSOverlayAssets>(nullptr, *Path);
+		}
+
+		for (TActorIterator<AALSCharacter> It(World); It; ++It)
+		{
+			if (It->OverlayAssets)
+			{
+				return It->OverlayAssets;
+			}
+		}
+		return nullptr;
+	}
+}
+
+bool FALSOverlayMemoryBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSOverlayMemoryBenchmark;
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this]()
+	{
+		UWorld* World = ALSBenchmark::GetGameWorld();
+		const UALSOverlayAssets* OverlayAssets = World ? FindOverlayAssets(World) : nullptr;
+		if (!OverlayAssets)
+		{
+			AddError(TEXT("Overlay memory benchmark needs ALS overlay assets, pass -ALSOverlayAssets=<Path> or set ")
+				TEXT("OverlayAssets on the character of the benchmark map"));
+			return true;
+		}
+
+		TArray<EALSOverlayState> AllStates;
+		for (uint8 Index = 0; Index <= static_cast<uint8>(EALSOverlayState::Barrel); ++Index)
+		{
+			AllStates.Add(static_cast<EALSOverlayState>(Index));
+		}
+
+		// Without streaming, the character references the held objects of every overlay state and keeps all loaded
+		TArray<FSoftObjectPath> AllAssets;
+		GetAssetsToLoad(*OverlayAssets, AllStates, AllAssets);
+		const TSharedPtr<FStreamableHandle> Handle = AllAssets.Num() > 0
+			                                             ? UAssetManager::GetStreamableManager().RequestSyncLoad(AllAssets)
+			                                             : nullptr;
+		const int64 HardRefBytes = GetLoadedBytes(AllAssets);
+
+		// With streaming, only the held object in use, its preloads and the initial preloads are kept loaded
+		TArray<FString> Rows;
+		int64 TotalStreamedBytes = 0;
+		int64 MaxStreamedBytes = 0;
+		for (const EALSOverlayState OverlayState : AllStates)
+		{
+			TArray<EALSOverlayState> LoadedStates = OverlayAssets->InitialPreloadOverlayStates;
+			LoadedStates.Add(OverlayState);
+			if (const FALSHeldObjectSettings* Settings = OverlayAssets->HeldObjects.Find(OverlayState))
+			{
+				LoadedStates.Append(Settings->PreloadOverlayStates);
+			}
+
+			TArray<FSoftObjectPath> StreamedAssets;
+			GetAssetsToLoad(*OverlayAssets, LoadedStates, StreamedAssets);
+			const int64 StreamedBytes = GetLoadedBytes(StreamedAssets);
+			TotalStreamedBytes += StreamedBytes;
+			MaxStreamedBytes = FMath::Max(MaxStreamedBytes, StreamedBytes);
+
+			Rows.Add(FString::Printf(TEXT("%s,%.1f,%d,%.1f,%d"),
+			                         *UEnum::GetDisplayValueAsText(OverlayState).ToString(), StreamedBytes / 1024.0,
+			                         StreamedAssets.Num(), HardRefBytes / 1024.0, AllAssets.Num()));
+		}
+
+		if (Handle.IsValid())
+		{
+			Handle->ReleaseHandle();
+		}
+
+		const FString FileName = ALSBenchmark::WriteCsv(
+			TEXT("OverlayMemory"), TEXT("OverlayState,StreamedKB,StreamedAssets,HardRefKB,HardRefAssets"), Rows);
+		AddInfo(FString::Printf(TEXT("Overlay memory of %s written to %s"), *OverlayAssets->GetPathName(), *FileName));
+
+		AddInfo(FString::Printf(
+			TEXT("Held object memory per character: %.1f KB average, %.1f KB worst overlay state with streaming, ")
+			TEXT("%.1f KB with every held object referenced"),
+			TotalStreamedBytes / 1024.0 / AllStates.Num(), MaxStreamedBytes / 1024.0, HardRefBytes / 1024.0));
+
+		ALSBenchmark::CheckBaseline(*this, TEXT("OverlayMemory.MaxStreamedKB"), MaxStreamedBytes / 1024.0);
+		return true;
+	}));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,172 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
+
+#include "Components/SkeletalMeshComponent.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSRagdollBenchmarkTest, "ALS.Benchmark.Ragdolls",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+namespace ALSRagdollBenchmark
+{
+	constexpr int32 NumRagdolls = 30;
+
+	/* Drive spring steps without quantization, the spring changes with nearly every velocity change as before*/
+	constexpr int32 UnquantizedSpringSteps = 1 << 20;
+
+	/* Ragdolls are pushed again at this interval, so they keep moving instead of settling*/
+	constexpr int32 PushIntervalFrames = 60;
+
+	struct FRunState
+	{
+		TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+		TArray<FString> Rows;
+		FDelegateHandle PreTickHandle;
+		FDelegateHandle PostTickHandle;
+		uint64 PhysicsStartCycles = 0;
+		uint64 FramePhysicsCycles = 0;
+		double PhysicsSeconds = 0.0;
+		double RagdollSeconds = 0.0;
+		double FrameSeconds = 0.0;
+		int32 Frames = 0;
+	};
+
+	static void PushRagdolls(const FRunState& State, int32 Frame)
+	{
+		FRandomStream Random(Frame);
+		for (const TWeakObjectPtr<AALSBaseCharacter>& Character : State.Characters)
+		{
+			if (Character.IsValid())
+			{
+				Character->GetMesh()->SetAllPhysicsLinearVelocity(
+					FVector(Random.FRandRange(-300.0f, 300.0f), Random.FRandRange(-300.0f, 300.0f), 400.0f), true);
+			}
+		}
+	}
+}
+
+bool FALSRagdollBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSRagdollBenchmark;
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	// Same ragdolls with the quantized drive spring, then with the spring applied on every change
+	const TSharedRef<FRunState> States[2] = {MakeShared<FRunState>(), MakeShared<FRunState>()};
+	for (int32 Run = 0; Run < 2; ++Run)
+	{
+		const bool bQuantized = Run == 0;
+		const TSharedRef<FRunState> State = States[Run];
+		const FString Name = FString::Printf(TEXT("Ragdolls%d%s"), NumRagdolls,
+		                                     bQuantized ? TEXT("Quantized") : TEXT("Unquantized"));
+
+		ALSBenchmark::FRunSettings Settings;
+		Settings.MeasuredFrames = 300;
+		Settings.Setup = [this, State, bQuantized](UWorld* World)
+		{
+			State->Characters.Append(ALSBenchmark::SpawnAICharacters(*this, World, NumRagdolls, 1500.0f));
+			for (const TWeakObjectPtr<AALSBaseCharacter>& Character : State->Characters)
+			{
+				if (!bQuantized)
+				{
+					Character->SetRagdollDriveSpringSteps(UnquantizedSpringSteps);
+				}
+				Character->RagdollStart();
+			}
+
+			// Span of the physics step, from the start of the simulation to the end of the frame waiting for its results
+			FPhysScene* PhysScene = World->GetPhysicsScene();
+			if (!PhysScene)
+			{
+				AddError(TEXT("Ragdoll benchmark needs a world with a physics scene"));
+				return false;
+			}
+			State->PreTickHandle = PhysScene->OnPhysScenePreTick.AddLambda([State](FPhysScene*, float)
+			{
+				State->PhysicsStartCycles = FPlatformTime::Cycles64();
+			});
+			State->PostTickHandle = PhysScene->OnPhysScenePostTick.AddLambda([State](FChaosScene*)
+			{
+				if (State->PhysicsStartCycles != 0)
+				{
+					State->FramePhysicsCycles += FPlatformTime::Cycles64() - State->PhysicsStartCycles;
+					State->PhysicsStartCycles = 0;
+				}
+			});
+			return State->Characters.Num() == NumRagdolls;
+		};
+		Settings.OnFrame = [State](int32 Frame, double FrameSeconds)
+		{
+			const double PhysicsSeconds = FPlatformTime::ToSeconds64(State->FramePhysicsCycles);
+			const double RagdollSeconds = ALSStageTimings::GetSeconds(EALSStage::Ragdoll);
+			State->FramePhysicsCycles = 0;
+			State->PhysicsSeconds += PhysicsSeconds;
+			State->RagdollSeconds += RagdollSeconds;
+			State->FrameSeconds += FrameSeconds;
+			State->Frames++;
+			State->Rows.Add(FString::Printf(TEXT("%d,%.4f,%.4f,%.4f,%s"), Frame, FrameSeconds * 1000.0,
+			                                PhysicsSeconds * 1000.0, RagdollSeconds * 1000.0,
+			                                *ALSBenchmark::GetStageCsvValues()));
+
+			if (Frame % PushIntervalFrames == 0)
+			{
+				PushRagdolls(*State, Frame);
+			}
+		};
+		Settings.Finish = [this, State, States, Name, bQuantized]()
+		{
+			if (UWorld* World = ALSBenchmark::GetGameWorld())
+			{
+				if (FPhysScene* PhysScene = World->GetPhysicsScene())
+				{
+					PhysScene->OnPhysScenePreTick.Remove(State->PreTickHandle);
+					PhysScene->OnPhysScenePostTick.Remove(State->PostTickHandle);
+				}
+			}
+			ALSBenchmark::DestroyCharacters(State->Characters);
+			if (State->Frames == 0)
+			{
+				return;
+			}
+
+			const FString FileName = ALSBenchmark::WriteCsv(
+				Name, TEXT("Frame,FrameMs,PhysicsMs,RagdollUpdateMs,") + ALSBenchmark::GetStageCsvHeader(),
+				State->Rows);
+			AddInfo(FString::Printf(TEXT("%s timings written to %s"), *Name, *FileName));
+
+			const double PhysicsMs = State->PhysicsSeconds * 1000.0 / State->Frames;
+			const double RagdollMs = State->RagdollSeconds * 1000.0 / State->Frames;
+			if (bQuantized)
+			{
+				ALSBenchmark::CheckBaseline(*this, Name + TEXT(".PhysicsMs"), PhysicsMs);
+				ALSBenchmark::CheckBaseline(*this, Name + TEXT(".RagdollUpdateMs"), RagdollMs);
+				return;
+			}
+
+			const TSharedRef<FRunState>& Quantized = States[0];
+			if (Quantized->Frames > 0)
+			{
+				AddInfo(FString::Printf(
+					TEXT("%d ragdolls per frame: physics %.3f ms quantized, %.3f ms unquantized. ")
+					TEXT("RagdollUpdate %.3f ms quantized, %.3f ms unquantized"),
+					NumRagdolls, Quantized->PhysicsSeconds * 1000.0 / Quantized->Frames, PhysicsMs,
+					Quantized->RagdollSeconds * 1000.0 / Quantized->Frames, RagdollMs));
+			}
+		};
+
+		ADD_LATENT_AUTOMATION_COMMAND(ALSBenchmark::FRunCommand(*this, MoveTemp(Settings)));
+	}
+
+	return true;
+}
+
+#endif
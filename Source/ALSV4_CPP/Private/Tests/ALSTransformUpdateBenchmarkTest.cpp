@@ -0,0 +1,141 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Tests/ALSBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Character/ALSBaseCharacter.h"
+#include "Library/ALSStats.h"
+
+#include "Components/SceneComponent.h"
+#include "Tests/AutomationCommon.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FALSTransformUpdateBenchmarkTest, "ALS.Benchmark.TransformUpdates",
+                                 EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+namespace ALSTransformUpdateBenchmark
+{
+	constexpr int32 NumCharacters = 50;
+
+	/* Every n-th character is ragdolled, so the ragdoll follow is measured next to the grounded rotation*/
+	constexpr int32 RagdollInterval = 4;
+
+	struct FRunState
+	{
+		TArray<TWeakObjectPtr<AALSBaseCharacter>> Characters;
+		TArray<FString> Rows;
+		int64 FrameUpdates = 0;
+		int64 Updates = 0;
+		double CharacterTickSeconds = 0.0;
+		int32 Frames = 0;
+	};
+
+	/* Count every transform update of the scene components of the character*/
+	static void CountTransformUpdates(const TSharedRef<FRunState>& State, AALSBaseCharacter& Character)
+	{
+		TInlineComponentArray<USceneComponent*> Components(&Character);
+		for (USceneComponent* Component : Components)
+		{
+			Component->TransformUpdated.AddLambda([State](USceneComponent*, EUpdateTransformFlags, ETeleportType)
+			{
+				State->FrameUpdates++;
+			});
+		}
+	}
+}
+
+bool FALSTransformUpdateBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace ALSTransformUpdateBenchmark;
+
+	AutomationOpenMap(ALSBenchmark::DemoMapPath);
+
+	// Same characters with the transform updates deferred to the end of the tick, then applied immediately
+	const TSharedRef<FRunState> States[2] = {MakeShared<FRunState>(), MakeShared<FRunState>()};
+	for (int32 Run = 0; Run < 2; ++Run)
+	{
+		const bool bDeferred = Run == 0;
+		const TSharedRef<FRunState> State = States[Run];
+		const FString Name = FString::Printf(TEXT("TransformUpdates%d%s"), NumCharacters,
+		                                     bDeferred ? TEXT("Deferred") : TEXT("Immediate"));
+
+		ALSBenchmark::FRunSettings Settings;
+		Settings.MeasuredFrames = 300;
+		Settings.Setup = [this, State, bDeferred](UWorld* World)
+		{
+			State->Characters.Append(ALSBenchmark::SpawnAICharacters(*this, World, NumCharacters, 1500.0f));
+			for (int32 Index = 0; Index < State->Characters.Num(); ++Index)
+			{
+				AALSBaseCharacter* Character = State->Characters[Index].Get();
+				Character->SetDeferTransformUpdates(bDeferred);
+				CountTransformUpdates(State, *Character);
+				if (Index % RagdollInterval == 0)
+				{
+					Character->RagdollStart();
+				}
+			}
+			return State->Characters.Num() == NumCharacters;
+		};
+		Settings.OnFrame = [State](int32 Frame, double FrameSeconds)
+		{
+			// The first measured frame also holds the updates of the warmup frames
+			const int64 FrameUpdates = State->FrameUpdates;
+			State->FrameUpdates = 0;
+			if (Frame == 0)
+			{
+				return;
+			}
+
+			const double CharacterTickSeconds = ALSStageTimings::GetSeconds(EALSStage::CharacterTick);
+			State->Updates += FrameUpdates;
+			State->CharacterTickSeconds += CharacterTickSeconds;
+			State->Frames++;
+			State->Rows.Add(FString::Printf(TEXT("%d,%.4f,%lld,%.3f,%.4f,%s"), Frame, FrameSeconds * 1000.0,
+			                                FrameUpdates, static_cast<double>(FrameUpdates) / NumCharacters,
+			                                CharacterTickSeconds * 1000.0, *ALSBenchmark::GetStageCsvValues()));
+		};
+		Settings.Finish = [this, State, States, Name, bDeferred]()
+		{
+			ALSBenchmark::DestroyCharacters(State->Characters);
+			if (State->Frames == 0)
+			{
+				return;
+			}
+
+			const FString FileName = ALSBenchmark::WriteCsv(
+				Name, TEXT("Frame,FrameMs,TransformUpdates,TransformUpdatesPerCharacter,CharacterTickMs,") +
+				ALSBenchmark::GetStageCsvHeader(), State->Rows);
+			AddInfo(FString::Printf(TEXT("%s transform updates written to %s"), *Name, *FileName));
+
+			const TSharedRef<FRunState>& Deferred = States[0];
+			if (bDeferred || Deferred->Frames == 0)
+			{
+				return;
+			}
+
+			const double DeferredUpdates = static_cast<double>(Deferred->Updates) / Deferred->Frames / NumCharacters;
+			const double ImmediateUpdates = static_cast<double>(State->Updates) / State->Frames / NumCharacters;
+			AddInfo(FString::Printf(
+				TEXT("%d characters, transform updates per character per frame: %.2f deferred, %.2f immediate. ")
+				TEXT("Character tick %.3f ms deferred, %.3f ms immediate"),
+				NumCharacters, DeferredUpdates, ImmediateUpdates,
+				Deferred->CharacterTickSeconds * 1000.0 / Deferred->Frames,
+				State->CharacterTickSeconds * 1000.0 / State->Frames));
+
+			if (DeferredUpdates > ImmediateUpdates)
+			{
+				AddError(FString::Printf(
+					TEXT("Deferring the transform updates increased them from %.2f to %.2f per character per frame"),
+					ImmediateUpdates, DeferredUpdates));
+			}
+		};
+
+		ADD_LATENT_AUTOMATION_COMMAND(ALSBenchmark::FRunCommand(*this, MoveTemp(Settings)));
+	}
+
+	return true;
+}
+
+#endif
@@ -6,6 +6,8 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
 #include "Runtime/AIModule/Classes/BehaviorTree/BehaviorTree.h"
 #include "ALSAIController.generated.h"
 
@@ -20,11 +22,73 @@ class ALSV4_CPP_API AALSAIController : public AAIController
 public:
 	AALSAIController();
 
+	virtual void Tick(float DeltaTime) override;
+
+	virtual void UpdateControlRotation(float DeltaTime, bool bUpdatePawn = true) override;
+
+	/** Apply the update rates of a tier and pass it to the possessed ALS character */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	void SetSignificanceTier(EALSSignificanceTier NewTier);
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|Significance")
+	EALSSignificanceTier GetSignificanceTier() const { return SignificanceTier; }
+
+	/** Turn the significance LOD on or off at runtime, turning it off restores the high significance rates */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	void SetUseSignificanceLOD(bool bNewUseSignificanceLOD);
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
 	TObjectPtr<UBehaviorTree> Behaviour = nullptr;
 
+	/** Pick a significance tier by distance to the closest viewer and scale AI update rates by it */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Significance")
+	bool bUseSignificanceLOD = false;
+
+	/** Pawns further than this distance from every viewer use medium significance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance", meta = (EditCondition = "bUseSignificanceLOD"))
+	float MediumSignificanceDistance = 2500.0f;
+
+	/** Pawns further than this distance from every viewer use low significance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance", meta = (EditCondition = "bUseSignificanceLOD"))
+	float LowSignificanceDistance = 6000.0f;
+
+	/** Distance a pawn needs to come closer than a tier distance before being promoted, prevents tier flickering */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance", meta = (EditCondition = "bUseSignificanceLOD"))
+	float SignificanceDistanceBuffer = 250.0f;
+
+	/** Interval in seconds between re-evaluating the significance tier */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance", meta = (EditCondition = "bUseSignificanceLOD"))
+	float SignificanceUpdateInterval = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance", meta = (EditCondition = "bUseSignificanceLOD"))
+	FALSAIUpdateRates HighSignificanceRates;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance", meta = (EditCondition = "bUseSignificanceLOD"))
+	FALSAIUpdateRates MediumSignificanceRates;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Significance", meta = (EditCondition = "bUseSignificanceLOD"))
+	FALSAIUpdateRates LowSignificanceRates;
+
 protected:
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void OnPossess(APawn* InPawn) override;
 
+	virtual void OnUnPossess() override;
+
 	virtual FVector GetFocalPointOnActor(const AActor *Actor) const override;
+
+private:
+	EALSSignificanceTier GetDesiredSignificanceTier() const;
+
+	void ApplyUpdateRates();
+
+	EALSSignificanceTier SignificanceTier = EALSSignificanceTier::High;
+
+	float TimeSinceSignificanceUpdate = 0.0f;
+
+	/* Delta time of the control rotation updates skipped since the last update*/
+	float SkippedFocusDeltaTime = 0.0f;
 };
@@ -0,0 +1,34 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "ALSBehaviorTreeComponent.generated.h"
+
+/**
+ * Behavior tree component with a minimum tick interval. The tree schedules its own ticks, so the interval
+ * is applied by accumulating skipped frames and passing the total delta time to the next tree tick.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+	                           FActorComponentTickFunction* ThisTickFunction) override;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|AI")
+	void SetMinTickInterval(float NewInterval) { MinTickInterval = FMath::Max(NewInterval, 0.0f); }
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|AI")
+	float GetMinTickInterval() const { return MinTickInterval; }
+
+private:
+	float MinTickInterval = 0.0f;
+
+	/* Delta time of the ticks skipped since the last tree tick*/
+	float SkippedDeltaTime = 0.0f;
+};
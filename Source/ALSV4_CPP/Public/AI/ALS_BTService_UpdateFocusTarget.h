@@ -0,0 +1,37 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Services/BTService_BlackboardBase.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "ALS_BTService_UpdateFocusTarget.generated.h"
+
+/** Periodically focuses the AIController on the nearest target found through the ALS target subsystem, and optionally writes it to the specified Blackboard Key. */
+UCLASS(Category = ALS, meta = (DisplayName = "Update Focus Target"))
+class ALSV4_CPP_API UALS_BTService_UpdateFocusTarget : public UBTService_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UALS_BTService_UpdateFocusTarget();
+
+	/** Maximum distance of the focused target from pawn. */
+	UPROPERTY(Category = Focus, EditAnywhere, meta = (ClampMin = 1))
+	float MaxDistance = 5000.0f;
+
+	/** Kind of pawns that can be focused. */
+	UPROPERTY(Category = Focus, EditAnywhere)
+	EALSFocusTargetType TargetType = EALSFocusTargetType::Players;
+
+	virtual FString GetStaticDescription() const override;
+
+protected:
+	virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+private:
+	void UpdateFocusTarget(UBehaviorTreeComponent& OwnerComp) const;
+};
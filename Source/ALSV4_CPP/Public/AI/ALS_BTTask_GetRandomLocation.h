@@ -8,6 +8,12 @@
 #include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
 #include "ALS_BTTask_GetRandomLocation.generated.h"
 
+struct FALSBTGetRandomLocationMemory
+{
+	/* Pending query of the nav query subsystem, 0 if none */
+	uint32 RequestId = 0;
+};
+
 /** Picks a random location reachable through NavMesh within the Max Distance from the Owning Pawn's current location and assigns it to the specified Blackboard Key. */
 UCLASS(Category=ALS, meta=(DisplayName = "Get Random Location"))
 class ALSV4_CPP_API UALS_BTTask_GetRandomLocation : public UBTTask_BlackboardBase
@@ -25,6 +31,15 @@ public:
 	UPROPERTY(Category = Navigation, EditAnywhere)
 	TSubclassOf<UNavigationQueryFilter> Filter = nullptr;
 
+	/** Draw the location from reachable points pooled per region when available, instead of querying each time. */
+	UPROPERTY(Category = Navigation, EditAnywhere)
+	bool bUsePointPool = false;
+
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual uint16 GetInstanceMemorySize() const override;
 	virtual FString GetStaticDescription() const override;
+
+private:
+	void OnQueryFinished(bool bSuccess, const FVector& Location, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
 };
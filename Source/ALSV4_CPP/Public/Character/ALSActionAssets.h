@@ -0,0 +1,37 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSActionAssets.generated.h"
+
+/**
+ * Soft referenced mantle, roll and get up assets of each overlay state. The assets of the current overlay state are
+ * streamed in as one set when it is picked, so the variants of the other overlay states stay unloaded.
+ */
+UCLASS(BlueprintType)
+class ALSV4_CPP_API UALSActionAssets : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Assets of the overlay state, or of DefaultActions if the overlay state has no entry */
+	const FALSOverlayActionAssets& GetActions(EALSOverlayState OverlayState) const
+	{
+		const FALSOverlayActionAssets* Actions = OverlayActions.Find(OverlayState);
+		return Actions ? *Actions : DefaultActions;
+	}
+
+public:
+	/** Used by overlay states without an entry in OverlayActions */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Actions")
+	FALSOverlayActionAssets DefaultActions;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Actions")
+	TMap<EALSOverlayState, FALSOverlayActionAssets> OverlayActions;
+};
@@ -8,20 +8,29 @@
 #include "Components/TimelineComponent.h"
 #include "Library/ALSCharacterEnumLibrary.h"
 #include "Library/ALSCharacterStructLibrary.h"
+#include "Library/ALSBoneIndexCache.h"
+#include "Library/ALSMovementModelCache.h"
 #include "Engine/DataTable.h"
 #include "GameFramework/Character.h"
+#include "UObject/ObjectKey.h"
 
 #include "ALSBaseCharacter.generated.h"
 
 // forward declarations
+class UALSActionAssets;
 class UALSDebugComponent;
+class UALSMeshRegistry;
+struct FStreamableHandle;
 class UAnimMontage;
 class UALSPlayerCameraBehavior;
+class UPhysicsAsset;
+class UCurveFloat;
 enum class EVisibilityBasedAnimTickOption : uint8;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FJumpPressedSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnJumpedSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FRagdollStateChangedSignature, bool, bRagdollState);
+DECLARE_MULTICAST_DELEGATE_OneParam(FCharacterStateEventSignature, AALSBaseCharacter*);
 
 /*
  * Base character class
@@ -44,13 +53,25 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PostInitializeComponents() override;
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/**
+	 * Bring a reused character back to its spawn state without destroying it: leaves ragdoll and mantle,
+	 * stops montages, re-applies the desired states and resets rotation and anim instance values.
+	 * Call after the actor is moved to its new location.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Pooling")
+	virtual void ResetALSState();
+
 	/** Ragdoll System */
 
-	/** Implement on BP to get required get up animation according to character's state */
+	/** Implement on BP to get required get up animation according to character's state, used if ActionAssets isn't set */
 	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, Category = "ALS|Ragdoll System")
 	UAnimMontage* GetGetUpAnimation(bool bRagdollFaceUpState);
 
@@ -63,6 +84,32 @@ public:
 	UFUNCTION(BlueprintCallable, Server, Unreliable, Category = "ALS|Ragdoll System")
 	void Server_SetMeshLocationDuringRagdoll(FVector MeshLocation);
 
+	UFUNCTION(BlueprintGetter, Category = "ALS|Ragdoll System")
+	bool IsRagdollSettled() const { return bRagdollSettled; }
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|Ragdoll System")
+	EALSRagdollLOD GetRagdollLOD() const { return RagdollLOD; }
+
+	/**
+	 * Swap the ragdoll physics asset for the given tier. Missing tier assets fall back to the next detailed tier.
+	 * Does nothing while the character isn't in ragdoll
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Ragdoll System")
+	void SetRagdollLOD(EALSRagdollLOD NewLOD);
+
+	/** Change RagdollDriveSpringSteps, the next ragdoll update applies the spring of the new step */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Ragdoll System")
+	void SetRagdollDriveSpringSteps(int32 NewSteps);
+
+	/** Significance */
+
+	/** Set by the controller by distance to the closest viewer, scales scene query priority and mesh update rate */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Significance")
+	void SetSignificanceTier(EALSSignificanceTier NewTier);
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|Significance")
+	EALSSignificanceTier GetSignificanceTier() const { return SignificanceTier; }
+
 	/** Character States */
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
@@ -92,6 +139,15 @@ public:
 	UFUNCTION(BlueprintGetter, Category = "ALS|Character States")
 	int32 GetOverlayOverrideState() const { return OverlayOverrideState; }
 
+	/**
+	 * Call the delegate when the movement state or stance changes and when movement input starts, until
+	 * RemoveStateEventListener is called with the same listener and instance id
+	 */
+	void AddStateEventListener(const UObject* Listener, int32 InstanceId,
+	                           FCharacterStateEventSignature::FDelegate&& Delegate);
+
+	void RemoveStateEventListener(const UObject* Listener, int32 InstanceId);
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Character States")
 	void SetGait(EALSGait NewGait, bool bForce = false);
 
@@ -223,6 +279,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
 	FALSMovementSettings GetTargetMovementSettings() const;
 
+	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
+	FALSMovementStateSettings GetMovementData() const;
+
+	const FDataTableRowHandle& GetMovementModelHandle() const { return MovementModel; }
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
 	EALSGait GetAllowedGait() const;
 
@@ -232,6 +293,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
 	bool CanSprint() const;
 
+	/** Change bDeferTransformUpdates, applies from the next tick */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Movement System")
+	void SetDeferTransformUpdates(bool bNewDeferTransformUpdates);
+
 	/** BP implementable function that called when Breakfall starts */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "ALS|Movement System")
 	void OnBreakfall();
@@ -242,7 +307,7 @@ public:
 	void Replicated_PlayMontage(UAnimMontage* Montage, float PlayRate);
 	virtual void Replicated_PlayMontage_Implementation(UAnimMontage* Montage, float PlayRate);
 
-	/** Implement on BP to get required roll animation according to character's state */
+	/** Implement on BP to get required roll animation according to character's state, used if ActionAssets isn't set */
 	UFUNCTION(BlueprintCallable, BlueprintImplementableEvent, Category = "ALS|Movement System")
 	UAnimMontage* GetRollAnimation();
 
@@ -257,6 +322,22 @@ public:
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Utility")
 	void Server_SetVisibleMesh(USkeletalMesh* NewSkeletalMesh);
 
+	/**
+	 * Stream the mesh in and swap to it once loaded, the current mesh stays visible meanwhile.
+	 * Meshes in the MeshRegistry replicate as their registry id
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Utility")
+	void SetVisibleMeshAsync(TSoftObjectPtr<USkeletalMesh> NewSkeletalMesh);
+
+	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "ALS|Utility")
+	void Server_SetVisibleMeshId(uint8 NewMeshId);
+
+	UFUNCTION(BlueprintGetter, Category = "ALS|Utility")
+	UALSActionAssets* GetActionAssets() const { return ActionAssets; }
+
+	/** Mantle asset of the current overlay state from ActionAssets, false if ActionAssets isn't set */
+	bool FindMantleActionAsset(EALSMantleType MantleType, FALSMantleAsset& OutMantleAsset) const;
+
 	/** Camera System */
 
 	UFUNCTION(BlueprintGetter, Category = "ALS|Camera System")
@@ -354,6 +435,16 @@ protected:
 
 	void SetActorLocationDuringRagdoll(float DeltaTime);
 
+	void RagdollSettle();
+
+	void RagdollWake();
+
+	/** Undo the settings RagdollStart changed, shared by RagdollEnd and ResetALSState */
+	void RagdollRestoreSettings();
+
+	/** Re-enable capsule collision, stop the mesh simulation and restore the pre ragdoll physics asset */
+	void RagdollRestorePhysics();
+
 	/** State Changes */
 
 	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
@@ -372,8 +463,33 @@ protected:
 
 	virtual void OnOverlayStateChanged(EALSOverlayState PreviousState);
 
+	/* Called after the character mesh component shows a new skeletal mesh*/
 	virtual void OnVisibleMeshChanged(const USkeletalMesh* PreviousSkeletalMesh);
 
+	void SetVisibleMeshId(uint8 NewMeshId);
+
+	/* Swap to the mesh of VisibleMeshId, streaming it in first if needed*/
+	void LoadVisibleMeshById();
+
+	void OnVisibleMeshLoaded(uint8 LoadedMeshId);
+
+	void CancelVisibleMeshLoad();
+
+	/* Show the mesh on the character mesh component, without changing VisibleMesh, VisibleMeshId or replicating them*/
+	void ApplyVisibleMesh(USkeletalMesh* NewVisibleMesh);
+
+	/* Stream in the action assets of the current overlay state, releasing the previous ones*/
+	void PreloadActionAssets();
+
+	UAnimMontage* FindRollAnimation();
+
+	UAnimMontage* FindGetUpAnimation(bool bRagdollFaceUpState);
+
+	virtual void OnSignificanceTierChanged(EALSSignificanceTier PreviousTier);
+
+	/** Apply the mesh tick interval and scene query priority of the current significance tier */
+	void ApplySignificanceTier();
+
 	virtual void OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust) override;
 
 	virtual void OnEndCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust) override;
@@ -400,8 +516,14 @@ protected:
 
 	void LimitRotation(float AimYawMin, float AimYawMax, float InterpSpeed, float DeltaTime);
 
+	float GetYawOffsetValue() const;
+
+	float GetRotationAmountValue(float DeltaTime);
+
 	void SetMovementModel();
 
+	void OnMovementModelsInvalidated(const UDataTable* DataTable);
+
 	void ForceUpdateCharacterState();
 
 	/** Replication */
@@ -417,6 +539,9 @@ protected:
 	UFUNCTION(Category = "ALS|Replication")
 	void OnRep_VisibleMesh(const USkeletalMesh* PreviousSkeletalMesh);
 
+	UFUNCTION(Category = "ALS|Replication")
+	void OnRep_VisibleMeshId();
+
 protected:
 	/* Custom movement component*/
 	UPROPERTY()
@@ -464,6 +589,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Movement System")
 	FDataTableRowHandle MovementModel;
 
+	/** Propagate the transform to attached components once per tick, instead of on every rotation or ragdoll move */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Movement System")
+	bool bDeferTransformUpdates = true;
+
 	/** Essential Information */
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Essential Information")
@@ -501,10 +630,30 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Essential Information")
 	FRotator ReplicatedControlRotation = FRotator::ZeroRotator;
 
-	/** Replicated Skeletal Mesh Information*/
+	/** Skeletal mesh replicated by reference, shown while VisibleMeshId is 0. Null while a registered mesh is shown */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Skeletal Mesh", ReplicatedUsing = OnRep_VisibleMesh)
 	TObjectPtr<USkeletalMesh> VisibleMesh = nullptr;
 
+	/** Meshes SetVisibleMesh and SetVisibleMeshAsync replicate by id instead of by reference */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Skeletal Mesh")
+	TObjectPtr<UALSMeshRegistry> MeshRegistry = nullptr;
+
+	/** Registry id of the visible mesh, 0 if the visible mesh is replicated by reference */
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Skeletal Mesh", ReplicatedUsing = OnRep_VisibleMeshId)
+	uint8 VisibleMeshId = 0;
+
+	/* Pending load of the next visible mesh*/
+	TSharedPtr<FStreamableHandle> VisibleMeshHandle;
+
+	/** Action Assets */
+
+	/** Soft referenced mantle, roll and get up assets. The Blueprint events providing them are used if not set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|Actions")
+	TObjectPtr<UALSActionAssets> ActionAssets = nullptr;
+
+	/* Keeps the action assets of the current overlay state loaded*/
+	TSharedPtr<FStreamableHandle> ActionAssetsHandle;
+
 	/** State Values */
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|State Values", ReplicatedUsing = OnRep_OverlayState)
@@ -539,8 +688,11 @@ protected:
 
 	/** Movement System */
 
-	UPROPERTY(BlueprintReadOnly, Category = "ALS|Movement System")
-	FALSMovementStateSettings MovementData;
+	/* Movement model row shared with all characters using the same row, resolved in SetMovementModel */
+	TSharedPtr<const FALSMovementModel> MovementData;
+
+	/* Index of the movement settings for the current rotation mode and stance */
+	int32 MovementSettingsIndex = 0;
 
 	/** Rotation System */
 
@@ -589,6 +741,46 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "ALS|Ragdoll System")
 	FVector TargetRagdollLocation = FVector::ZeroVector;
 
+	/** If enabled, ragdoll stops updating and puts its bodies to sleep once it comes to rest on the ground */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Ragdoll System")
+	bool bEnableRagdollSettling = true;
+
+	/** Ragdoll is considered at rest while its velocity is lower than this value */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Ragdoll System", meta = (EditCondition ="bEnableRagdollSettling"))
+	float RagdollSettleVelocity = 5.0f;
+
+	/** Amount of consecutive frames the ragdoll needs to stay at rest before settling */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Ragdoll System", meta = (EditCondition ="bEnableRagdollSettling", ClampMin = 1))
+	int32 RagdollSettleFrameCount = 30;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Ragdoll System")
+	bool bRagdollSettled = false;
+
+	/** Ragdoll joint drive spring is quantized into this many steps, and motors are only updated when the step changes */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Ragdoll System", meta = (ClampMin = 1))
+	int32 RagdollDriveSpringSteps = 8;
+
+	/** Physics asset with fewer bodies and constraints, used by ragdolls at reduced LOD. Full asset is used if not set */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Ragdoll System")
+	TObjectPtr<UPhysicsAsset> ReducedRagdollPhysicsAsset = nullptr;
+
+	/** Single body (pelvis only) physics asset, used by distant ragdolls. Reduced asset is used if not set */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Ragdoll System")
+	TObjectPtr<UPhysicsAsset> SimpleRagdollPhysicsAsset = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Ragdoll System")
+	EALSRagdollLOD RagdollLOD = EALSRagdollLOD::Full;
+
+	/* Physics asset of the mesh before ragdoll started, restored on ragdoll end*/
+	UPROPERTY()
+	TObjectPtr<UPhysicsAsset> PreRagdollPhysicsAsset = nullptr;
+
+	/* Last applied ragdoll joint drive spring step, INDEX_NONE if motors need a refresh*/
+	int32 RagdollDriveSpringStep = INDEX_NONE;
+
+	/* Consecutive frames spent below the settle velocity*/
+	int32 RagdollSettleFrames = 0;
+
 	/* Server ragdoll pull force storage*/
 	float ServerRagdollPull = 0.0f;
 
@@ -597,8 +789,63 @@ protected:
 
 	bool bPreRagdollURO = false;
 
+	/** Significance */
+
+	UPROPERTY(BlueprintReadOnly, Category = "ALS|Significance")
+	EALSSignificanceTier SignificanceTier = EALSSignificanceTier::High;
+
+	/** Mesh tick interval of medium significance characters. Ragdolls always tick their mesh every frame */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Significance", meta = (ClampMin = 0))
+	float MediumSignificanceMeshTickInterval = 0.0f;
+
+	/** Mesh tick interval of low significance characters. Ragdolls always tick their mesh every frame */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Significance", meta = (ClampMin = 0))
+	float LowSignificanceMeshTickInterval = 0.1f;
+
+	/** Scene query priority scale of medium significance characters, in (0, 1] range */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Significance", meta = (ClampMin = 0.01, ClampMax = 1))
+	float MediumSignificanceQueryScale = 0.5f;
+
+	/** Scene query priority scale of low significance characters, in (0, 1] range */
+	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "ALS|Significance", meta = (ClampMin = 0.01, ClampMax = 1))
+	float LowSignificanceQueryScale = 0.25f;
+
+	/** Server Animation */
+
+	/** On dedicated servers, sample rotation curves from baked curves instead of the anim graph
+	 * and stop ticking the anim graph of non-ragdoll characters. Montages are still ticked */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "ALS|Server Animation")
+	bool bUseBakedCurvesOnServer = false;
+
+	/** YawOffset curve value baked from locomotion cycles, keyed by velocity direction relative to aiming direction (-180, 180) */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "ALS|Server Animation", meta = (EditCondition ="bUseBakedCurvesOnServer"))
+	TObjectPtr<UCurveFloat> BakedYawOffsetCurve = nullptr;
+
+	/** RotationAmount curve baked from a 90 degree right turn in place animation, scaled by the actual turn angle */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "ALS|Server Animation", meta = (EditCondition ="bUseBakedCurvesOnServer"))
+	TObjectPtr<UCurveFloat> BakedTurnInPlaceCurve = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "ALS|Server Animation", meta = (EditCondition ="bUseBakedCurvesOnServer"))
+	float BakedTurnCheckMinAngle = 45.0f;
+
+	/** Time the aiming angle needs to stay above the min angle before turning in place */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "ALS|Server Animation", meta = (EditCondition ="bUseBakedCurvesOnServer"))
+	float BakedTurnDelay = 0.5f;
+
+	bool bUsingBakedCurves = false;
+
+	/* Elapsed time of the active baked turn in place, negative if not turning*/
+	float BakedTurnTime = -1.0f;
+
+	float BakedTurnScale = 0.0f;
+
+	float BakedTurnDelayTime = 0.0f;
+
 	/** Cached Variables */
 
+	/* Resolved bone indices for per frame socket queries on the character mesh*/
+	FALSBoneIndexCache BoneIndexCache;
+
 	FVector PreviousVelocity = FVector::ZeroVector;
 
 	float PreviousAimYaw = 0.0f;
@@ -621,4 +868,9 @@ protected:
 private:
 	UPROPERTY()
 	TObjectPtr<UALSDebugComponent> ALSDebugComponent = nullptr;
+
+	FCharacterStateEventSignature StateEvent;
+
+	/* Delegate handles in StateEvent of each listener and instance id*/
+	TMap<TPair<FObjectKey, int32>, FDelegateHandle> StateEventListeners;
 };
@@ -8,6 +8,9 @@
 #include "Character/ALSBaseCharacter.h"
 #include "ALSCharacter.generated.h"
 
+class UALSOverlayAssets;
+struct FStreamableHandle;
+
 /**
  * Specialized character class, with additional features like held object etc.
  */
@@ -19,10 +22,14 @@ class ALSV4_CPP_API AALSCharacter : public AALSBaseCharacter
 public:
 	AALSCharacter(const FObjectInitializer& ObjectInitializer);
 
-	/** Implemented on BP to update held objects */
+	/** Implemented on BP to update held objects, used instead of OverlayAssets if bUseBlueprintHeldObject is set */
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "ALS|HeldObject")
 	void UpdateHeldObject();
 
+	/** Attach the held object of the current overlay state once streamed in, and update its animations */
+	UFUNCTION(BlueprintCallable, Category = "ALS|HeldObject")
+	void RefreshHeldObject();
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|HeldObject")
 	void ClearHeldObject();
 
@@ -34,6 +41,8 @@ public:
 
 	virtual void RagdollEnd() override;
 
+	virtual void ResetALSState() override;
+
 	virtual ECollisionChannel GetThirdPersonTraceParams(FVector& TraceOrigin, float& TraceRadius) override;
 
 	virtual FTransform GetThirdPersonPivotTarget() override;
@@ -45,12 +54,26 @@ protected:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void OnOverlayStateChanged(EALSOverlayState PreviousState) override;
 
-	/** Implement on BP to update animation states of held objects */
+	virtual void OnStanceChanged(EALSStance PreviousStance) override;
+
+	virtual void OnRotationModeChanged(EALSRotationMode PreviousRotationMode) override;
+
+	/**
+	 * Implement on BP to update animation states of held objects. Called when the overlay state, stance or aiming
+	 * changes, and every tick while bTickHeldObjectAnimations is set
+	 */
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "ALS|HeldObject")
 	void UpdateHeldObjectAnimations();
 
+	bool UsesBlueprintHeldObject() const { return bUseBlueprintHeldObject || !OverlayAssets; }
+
+	/* Call UpdateHeldObjectAnimations if the overlay state, stance or aiming changed since the last call*/
+	void UpdateHeldObjectAnimationState(bool bForce = false);
+
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Component")
 	TObjectPtr<USceneComponent> HeldObjectRoot = nullptr;
@@ -61,6 +84,45 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Component")
 	TObjectPtr<UStaticMeshComponent> StaticMesh = nullptr;
 
+	/** Soft referenced held objects of each overlay state */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|HeldObject")
+	TObjectPtr<UALSOverlayAssets> OverlayAssets = nullptr;
+
+	/** Use the UpdateHeldObject Blueprint event instead of OverlayAssets. Also used while OverlayAssets is not set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|HeldObject")
+	bool bUseBlueprintHeldObject = false;
+
+	/**
+	 * Call UpdateHeldObjectAnimations every tick if it is implemented. Needed while it drives held objects from
+	 * animation curves, like the bow draw of the default character. Clear it if the Blueprint only reacts to overlay
+	 * state, stance and aiming changes
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ALS|HeldObject")
+	bool bTickHeldObjectAnimations = true;
+
 private:
+	/* Whether the Blueprint implements UpdateHeldObjectAnimations, so ticks don't call an empty event*/
+	bool bHasHeldObjectAnimations = false;
+
 	bool bNeedsColorReset = false;
+
+	/* Overlay state, stance and aiming of the last UpdateHeldObjectAnimations call*/
+	EALSOverlayState HeldObjectOverlayState = EALSOverlayState::Default;
+
+	EALSStance HeldObjectStance = EALSStance::Standing;
+
+	bool bHeldObjectAiming = false;
+
+	void OnHeldObjectLoaded(EALSOverlayState LoadedOverlayState);
+
+	/* Stream in the held objects of the overlay states, releasing the previous preloads*/
+	void PreloadHeldObjects(const TArray<EALSOverlayState>& OverlayStates);
+
+	/* Load of the held object of the current overlay state*/
+	TSharedPtr<FStreamableHandle> HeldObjectHandle;
+
+	/* Keeps the held objects of the likely next overlay states loaded*/
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
+	TSharedPtr<FStreamableHandle> InitialPreloadHandle;
 };
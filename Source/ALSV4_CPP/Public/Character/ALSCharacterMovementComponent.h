@@ -44,6 +44,9 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 		virtual FSavedMovePtr AllocateNewMove() override;
 	};
 
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+	                           FActorComponentTickFunction* ThisTickFunction) override;
+
 	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 	virtual void OnMovementUpdated(float DeltaTime, const FVector& OldLocation, const FVector& OldVelocity) override;
@@ -67,7 +70,7 @@ class ALSV4_CPP_API UALSCharacterMovementComponent : public UCharacterMovementCo
 	float GetMappedSpeed() const;
 
 	UFUNCTION(BlueprintCallable, Category = "Movement Settings")
-	void SetMovementSettings(FALSMovementSettings NewMovementSettings);
+	void SetMovementSettings(const FALSMovementSettings& NewMovementSettings);
 
 	// Set Max Walking Speed (Called from the owning client)
 	UFUNCTION(BlueprintCallable, Category = "Movement Settings")
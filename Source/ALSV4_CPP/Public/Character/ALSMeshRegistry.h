@@ -0,0 +1,38 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+
+#include "ALSMeshRegistry.generated.h"
+
+class USkeletalMesh;
+
+/**
+ * Skeletal meshes characters can swap to. A mesh is identified by a one byte id instead of an object reference,
+ * so swaps replicate compactly and clients stream the mesh in instead of loading it on arrival.
+ */
+UCLASS(BlueprintType)
+class ALSV4_CPP_API UALSMeshRegistry : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Id 0 is reserved for meshes not in the registry */
+	static constexpr int32 MaxMeshes = MAX_uint8;
+
+	/** Id of the mesh, 0 if it isn't registered */
+	uint8 FindMeshId(const TSoftObjectPtr<USkeletalMesh>& Mesh) const;
+
+	TSoftObjectPtr<USkeletalMesh> GetMesh(uint8 MeshId) const;
+
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(FDataValidationContext& Context) const override;
+#endif
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Skeletal Mesh")
+	TArray<TSoftObjectPtr<USkeletalMesh>> Meshes;
+};
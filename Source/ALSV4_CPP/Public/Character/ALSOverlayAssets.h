@@ -0,0 +1,30 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSOverlayAssets.generated.h"
+
+/**
+ * Soft referenced held objects of each overlay state. Only the held object in use and the ones likely to be
+ * picked next are loaded, instead of every prop the character could hold.
+ */
+UCLASS(BlueprintType)
+class ALSV4_CPP_API UALSOverlayAssets : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Object held in each overlay state. Overlay states without an entry hold nothing */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|HeldObject")
+	TMap<EALSOverlayState, FALSHeldObjectSettings> HeldObjects;
+
+	/** Overlay states streamed in on BeginPlay, before any of them is picked */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|HeldObject")
+	TArray<EALSOverlayState> InitialPreloadOverlayStates;
+};
@@ -5,10 +5,12 @@
 
 #include "CoreMinimal.h"
 #include "InputActionValue.h"
+#include "Library/ALSCharacterEnumLibrary.h"
 #include "GameFramework/PlayerController.h"
 #include "ALSPlayerController.generated.h"
 
 class AALSBaseCharacter;
+class UALSInputReplayComponent;
 class UInputMappingContext;
 
 /**
@@ -33,6 +35,11 @@ protected:
 
 	void SetupCamera();
 
+	/** Live input is ignored while an input replay drives the possessed character */
+	bool CanForwardInput() const;
+
+	void RecordInput(EALSReplayInputAction Action, float Value) const;
+
 	UFUNCTION()
 	void ForwardMovementAction(const FInputActionValue& Value);
 
@@ -119,4 +126,9 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "ALS|Input")
 	TObjectPtr<UInputMappingContext> DebugInputMappingContext = nullptr;
+
+private:
+	/* Optional recorder on the possessed character */
+	UPROPERTY()
+	TObjectPtr<UALSInputReplayComponent> InputReplayComponent = nullptr;
 };
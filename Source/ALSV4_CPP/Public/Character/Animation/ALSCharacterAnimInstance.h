@@ -7,6 +7,7 @@
 #include "Animation/AnimInstance.h"
 #include "Library/ALSAnimationStructLibrary.h"
 #include "Library/ALSStructEnumLibrary.h"
+#include "Library/ALSBoneIndexCache.h"
 
 #include "ALSCharacterAnimInstance.generated.h"
 
@@ -41,6 +42,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Animation")
 	void PlayDynamicTransition(float ReTriggerDelay, FALSDynamicMontageParams Parameters);
 
+	/** Reset runtime graph values and pending transition timers, used when a pooled character is reused */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Animation")
+	void ResetAnimationValues();
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Event")
 	void OnJumped();
 
@@ -297,6 +302,9 @@ private:
 
 	bool bCanPlayDynamicTransition = true;
 
+	/* Resolved bone indices of the owning mesh, used by foot IK and transition checks*/
+	FALSBoneIndexCache BoneIndexCache;
+
 	UPROPERTY()
 	TObjectPtr<UALSDebugComponent> ALSDebugComponent = nullptr;
 };
@@ -33,6 +33,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Socket")
 	FName FootSocketName = NAME_Foot_R;
 
+	/** Footsteps on the visibility channel share the ground probes of foot IK */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trace")
 	TEnumAsByte<ETraceTypeQuery> TraceChannel;
 
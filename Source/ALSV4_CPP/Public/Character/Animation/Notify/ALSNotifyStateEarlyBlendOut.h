@@ -10,19 +10,26 @@
 
 #include "ALSNotifyStateEarlyBlendOut.generated.h"
 
+class AALSBaseCharacter;
+
 /**
- * Character early blend out anim state
+ * Character early blend out anim state. Checks the conditions on the character's state events instead of every tick
  */
 UCLASS()
 class ALSV4_CPP_API UALSNotifyStateEarlyBlendOut : public UAnimNotifyState
 {
 	GENERATED_BODY()
 
-	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime,
-	                        const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
+	                         const FAnimNotifyEventReference& EventReference) override;
+
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+	                       const FAnimNotifyEventReference& EventReference) override;
 
 	virtual FString GetNotifyName_Implementation() const override;
 
+	bool ShouldBlendOut(const AALSBaseCharacter* Character) const;
+
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = AnimNotify)
 	TObjectPtr<UAnimMontage> ThisMontage = nullptr;
@@ -147,8 +147,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Debug")
 	bool bShowCharacterInfo = false;
 
+	/** Streamed in on first toggle instead of being loaded with the character */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS|Debug")
-	TObjectPtr<USkeletalMesh> DebugSkeletalMesh = nullptr;
+	TSoftObjectPtr<USkeletalMesh> DebugSkeletalMesh = nullptr;
 
 	UPROPERTY(BlueprintReadOnly, Category = "ALS|Debug")
 	TArray<TObjectPtr<AALSBaseCharacter>> AvailableDebugCharacters;
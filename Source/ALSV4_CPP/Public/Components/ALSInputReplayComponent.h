@@ -0,0 +1,124 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSInputReplayComponent.generated.h"
+
+class AALSBaseCharacter;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FALSInputReplayFinishedSignature, const FALSReplayChecksum&, Checksum);
+
+/**
+ * Records the input stream AALSPlayerController forwards to its character, and plays it back onto the
+ * character with a fixed timestep. Replays report transform and state checksums so locomotion changes can be
+ * checked as behavior preserving and timed on identical workloads.
+ *
+ * Replays restore the recorded start transform and control rotation, and are meant to run on a freshly spawned
+ * character. Headless usage: -ALSReplay=<File> replays the file on the first character owning this component in
+ * each game or PIE session, add -ALSReplayExit to quit once the checksums are logged.
+ */
+UCLASS(Blueprintable, BlueprintType, ClassGroup = (ALS), meta = (BlueprintSpawnableComponent))
+class ALSV4_CPP_API UALSInputReplayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UALSInputReplayComponent();
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Input Replay")
+	void StartRecording();
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Input Replay")
+	void StopRecording();
+
+	/** Restore the recorded start pose and play the recorded frames back, one per engine frame */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Input Replay")
+	bool StartReplay();
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Input Replay")
+	void StopReplay();
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Input Replay")
+	bool SaveRecording(const FString& FileName) const;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Input Replay")
+	bool LoadRecording(const FString& FileName);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Input Replay")
+	FALSReplayChecksum ComputeChecksum() const;
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Input Replay")
+	bool IsRecording() const { return bRecording; }
+
+	UFUNCTION(BlueprintPure, Category = "ALS|Input Replay")
+	bool IsReplaying() const { return bReplaying; }
+
+	/** Called by the player controller for every input it forwards to the character */
+	void RecordInput(EALSReplayInputAction Action, float Value);
+
+	UPROPERTY(BlueprintAssignable, Category = "ALS|Input Replay")
+	FALSInputReplayFinishedSignature OnReplayFinished;
+
+	/** Timestep used during replay, 0 replays each frame with its recorded delta time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input Replay", meta = (ClampMin = 0.0f))
+	float ReplayFixedDeltaTime = 0.0f;
+
+	/** Grid the transform is snapped to before hashing, so checksums survive last-bit float differences */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Input Replay", meta = (ClampMin = 0.0f))
+	float ChecksumTolerance = 0.01f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Input Replay")
+	TArray<FALSReplayInputFrame> Frames;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Input Replay")
+	FTransform StartTransform;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS|Input Replay")
+	FRotator StartControlRotation = FRotator::ZeroRotator;
+
+private:
+	/* Replay input is dispatched before any actor ticks, so the character sees it exactly like live input */
+	void OnWorldPreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/* Recorded input is closed into a frame after all actors ticked, once the controller processed its input */
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void DispatchEvent(const FALSReplayInputEvent& Event) const;
+
+	void SetReplayDeltaTime(float DeltaTime) const;
+
+	void FinishReplay();
+
+	UPROPERTY()
+	TObjectPtr<AALSBaseCharacter> OwnerCharacter = nullptr;
+
+	/* Input forwarded during the current frame */
+	FALSReplayInputFrame PendingFrame;
+
+	FDelegateHandle WorldTickHandle;
+
+	int32 ReplayFrameIndex = 0;
+
+	double ReplayStartTime = 0.0;
+
+	bool bRecording = false;
+
+	bool bReplaying = false;
+
+	bool bExitAfterReplay = false;
+
+	/* Engine fixed timestep settings to restore once the replay ends */
+	bool bPrevUseFixedTimeStep = false;
+
+	double PrevFixedDeltaTime = 0.0;
+};
@@ -37,13 +37,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System")
 	void MantleEnd();
 
+	/** Stop an active mantle without running MantleEnd, used when a pooled character is reset */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System")
+	void ResetMantle();
+
 	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System")
 	void OnOwnerJumpInput();
 
 	UFUNCTION(BlueprintCallable, Category = "ALS|Mantle System")
 	void OnOwnerRagdollStateChanged(bool bRagdollState);
 
-	/** Implement on BP to get correct mantle parameter set according to character state */
+	/** Implement on BP to get correct mantle parameter set according to character state, used if the owner has no ActionAssets */
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "ALS|Mantle System")
 	FALSMantleAsset GetMantleAsset(EALSMantleType MantleType, EALSOverlayState CurrentOverlayState);
 
@@ -0,0 +1,49 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USkinnedAsset;
+class USkinnedMeshComponent;
+
+/**
+ * Per mesh cache of resolved bone indices and socket offsets. Sockets and bones are resolved by name once,
+ * and later queries read the component space transforms of the mesh directly by index.
+ */
+struct ALSV4_CPP_API FALSBoneIndexCache
+{
+	/** Clear all resolved names, call when the mesh asset changes */
+	void Reset();
+
+	/** Returns the transform of a socket or bone, resolving and caching its bone index on first use */
+	FTransform GetSocketTransform(const USkinnedMeshComponent* Mesh, FName SocketName,
+	                              ERelativeTransformSpace TransformSpace = RTS_World);
+
+	FVector GetSocketLocation(const USkinnedMeshComponent* Mesh, FName SocketName)
+	{
+		return GetSocketTransform(Mesh, SocketName).GetLocation();
+	}
+
+	FRotator GetSocketRotation(const USkinnedMeshComponent* Mesh, FName SocketName)
+	{
+		return GetSocketTransform(Mesh, SocketName).Rotator();
+	}
+
+private:
+	struct FEntry
+	{
+		FName Name;
+		int32 BoneIndex = INDEX_NONE;
+
+		/* Socket offset relative to its bone, identity for bones*/
+		FTransform LocalTransform = FTransform::Identity;
+	};
+
+	const FEntry& FindOrAddEntry(const USkinnedMeshComponent* Mesh, FName SocketName);
+
+	TArray<FEntry, TInlineAllocator<16>> Entries;
+
+	TWeakObjectPtr<const USkinnedAsset> CachedAsset;
+};
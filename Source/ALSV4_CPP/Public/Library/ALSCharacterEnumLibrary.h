@@ -168,3 +168,57 @@ enum class EALSSpawnType : uint8
 	Location,
 	Attached
 };
+
+UENUM(BlueprintType, meta = (ScriptName = "ALS_RagdollLOD"))
+enum class EALSRagdollLOD : uint8
+{
+	Full,
+	Reduced,
+	Simple
+};
+
+UENUM(BlueprintType, meta = (ScriptName = "ALS_SceneQueryType"))
+enum class EALSSceneQueryType : uint8
+{
+	FootIK,
+	LandPrediction,
+	Camera,
+	Mantle,
+	Ragdoll,
+	Footstep
+};
+
+UENUM(BlueprintType, meta = (ScriptName = "ALS_ReplayInputAction"))
+enum class EALSReplayInputAction : uint8
+{
+	ForwardMovement,
+	RightMovement,
+	CameraUp,
+	CameraRight,
+	Jump,
+	Sprint,
+	Aim,
+	CameraTap,
+	CameraHeld,
+	Stance,
+	Walk,
+	Ragdoll,
+	VelocityDirection,
+	LookingDirection
+};
+
+UENUM(BlueprintType, meta = (ScriptName = "ALS_FocusTargetType"))
+enum class EALSFocusTargetType : uint8
+{
+	Players,
+	Characters,
+	Any
+};
+
+UENUM(BlueprintType, meta = (ScriptName = "ALS_SignificanceTier"))
+enum class EALSSignificanceTier : uint8
+{
+	High,
+	Medium,
+	Low
+};
@@ -20,6 +20,9 @@ class UNiagaraSystem;
 class UMaterialInterface;
 class USoundBase;
 class UPrimitiveComponent;
+class UStaticMesh;
+class USkeletalMesh;
+class UAnimInstance;
 
 USTRUCT(BlueprintType)
 struct FALSComponentAndTransform
@@ -308,3 +311,250 @@ struct FALSHitFX : public FTableRowBase
 	UPROPERTY(EditAnywhere, Category = "Niagara")
 	FRotator NiagaraRotationOffset = FRotator::ZeroRotator;
 };
+
+USTRUCT(BlueprintType)
+struct FALSSceneQueryStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scene Query")
+	int32 Requested = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scene Query")
+	int32 Executed = 0;
+
+	/** Over budget queries, answered with the result of a previous frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scene Query")
+	int32 Deferred = 0;
+
+	/** Queries answered with a result already executed in the same frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scene Query")
+	int32 Reused = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scene Query")
+	int32 GroundProbes = 0;
+
+	/** Ground probes answered from another probe of the same character at the same spot in the same frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scene Query")
+	int32 GroundProbesShared = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FALSReplayInputEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Replay")
+	EALSReplayInputAction Action = EALSReplayInputAction::ForwardMovement;
+
+	/** Axis magnitude, or 0/1 for button actions */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Replay")
+	float Value = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FALSReplayInputFrame
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Replay")
+	float DeltaTime = 0.0f;
+
+	/** Input forwarded to the character during this frame, in arrival order */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Replay")
+	TArray<FALSReplayInputEvent> Events;
+};
+
+USTRUCT(BlueprintType)
+struct FALSReplayChecksum
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input Replay")
+	int32 Frames = 0;
+
+	/** CRC of the quantized final location, rotation and velocity */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input Replay")
+	int32 TransformChecksum = 0;
+
+	/** CRC of the final movement state, action, gait, stance, rotation mode, view mode and overlay state */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input Replay")
+	int32 StateChecksum = 0;
+
+	/** Wall clock time spent replaying, for timing identical workloads */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input Replay")
+	float ElapsedSeconds = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FALSCharacterPoolStats
+{
+	GENERATED_BODY()
+
+	/** Characters created with SpawnActor because the pool was empty */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character Pool")
+	int32 Spawned = 0;
+
+	/** Characters handed out again from the pool */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character Pool")
+	int32 Reused = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character Pool")
+	int32 Released = 0;
+
+	/** Average cost of a spawn, including BeginPlay and controller possession */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character Pool")
+	float AverageSpawnMs = 0.0f;
+
+	/** Average cost of reactivating a pooled character, including ResetALSState */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Character Pool")
+	float AverageReuseMs = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FALSAIUpdateRates
+{
+	GENERATED_BODY()
+
+	/** Minimum time between behavior tree ticks, 0 ticks the tree whenever it requests */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|AI", meta = (ClampMin = 0))
+	float BehaviorTreeInterval = 0.0f;
+
+	/** Minimum time between control rotation updates towards the focal point */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|AI", meta = (ClampMin = 0))
+	float FocusInterval = 0.0f;
+
+	/** Tick interval of the path following component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|AI", meta = (ClampMin = 0))
+	float PathFollowingInterval = 0.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FALSHeldObjectSettings
+{
+	GENERATED_BODY()
+
+	/** Mesh held in hand, takes precedence over the skeletal mesh */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Held Object")
+	TSoftObjectPtr<UStaticMesh> StaticMesh = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Held Object")
+	TSoftObjectPtr<USkeletalMesh> SkeletalMesh = nullptr;
+
+	/** Anim class of the held skeletal mesh */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Held Object")
+	TSoftClassPtr<UAnimInstance> AnimClass;
+
+	/** Attach to the left hand gun bone instead of the right one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Held Object")
+	bool bLeftHand = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Held Object")
+	FVector Offset = FVector::ZeroVector;
+
+	/** Overlay states likely to be picked next, their held objects are streamed in while this one is held */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Held Object")
+	TArray<EALSOverlayState> PreloadOverlayStates;
+
+	/** Assets to stream before the held object can be attached */
+	void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const
+	{
+		for (const FSoftObjectPath& Path : {StaticMesh.ToSoftObjectPath(), SkeletalMesh.ToSoftObjectPath(),
+		                                     AnimClass.ToSoftObjectPath()})
+		{
+			if (!Path.IsNull())
+			{
+				OutAssets.Add(Path);
+			}
+		}
+	}
+};
+
+/** Soft referenced FALSMantleAsset, only streamed in with the action assets of its overlay state */
+USTRUCT(BlueprintType)
+struct FALSSoftMantleAsset
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	TSoftObjectPtr<UAnimMontage> AnimMontage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	TSoftObjectPtr<UCurveVector> PositionCorrectionCurve;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FVector StartingOffset = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float LowHeight = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float LowPlayRate = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float LowStartPosition = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float HighHeight = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float HighPlayRate = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	float HighStartPosition = 0.0f;
+};
+
+/** Montages and curves of the mantle, roll and get up actions of one overlay state */
+USTRUCT(BlueprintType)
+struct FALSOverlayActionAssets
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FALSSoftMantleAsset HighMantle;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FALSSoftMantleAsset LowMantle;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Mantle System")
+	FALSSoftMantleAsset FallingCatch;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement System")
+	TSoftObjectPtr<UAnimMontage> Roll;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ragdoll System")
+	TSoftObjectPtr<UAnimMontage> GetUpFaceUp;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ragdoll System")
+	TSoftObjectPtr<UAnimMontage> GetUpFaceDown;
+
+	const FALSSoftMantleAsset& GetMantleAsset(EALSMantleType MantleType) const
+	{
+		switch (MantleType)
+		{
+		case EALSMantleType::HighMantle:
+			return HighMantle;
+		case EALSMantleType::LowMantle:
+			return LowMantle;
+		default:
+			return FallingCatch;
+		}
+	}
+
+	/** Every asset of the overlay state, streamed in together when the overlay state is picked */
+	void GetAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const
+	{
+		for (const FSoftObjectPath& Path : {
+			     HighMantle.AnimMontage.ToSoftObjectPath(), HighMantle.PositionCorrectionCurve.ToSoftObjectPath(),
+			     LowMantle.AnimMontage.ToSoftObjectPath(), LowMantle.PositionCorrectionCurve.ToSoftObjectPath(),
+			     FallingCatch.AnimMontage.ToSoftObjectPath(), FallingCatch.PositionCorrectionCurve.ToSoftObjectPath(),
+			     Roll.ToSoftObjectPath(), GetUpFaceUp.ToSoftObjectPath(), GetUpFaceDown.ToSoftObjectPath()
+		     })
+		{
+			if (!Path.IsNull())
+			{
+				OutAssets.AddUnique(Path);
+			}
+		}
+	}
+};
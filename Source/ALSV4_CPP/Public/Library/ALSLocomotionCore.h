@@ -0,0 +1,222 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+// Engine independent ALS locomotion math. Only plain values go in and out, so this header doesn't include any engine
+// headers and can be compiled on its own. Enum values match the ALS enums with the same names.
+
+#include <cmath>
+#include <cstdint>
+
+namespace ALSLocomotionCore
+{
+	enum class EGait : uint8_t
+	{
+		Walking,
+		Running,
+		Sprinting
+	};
+
+	enum class EStance : uint8_t
+	{
+		Standing,
+		Crouching
+	};
+
+	enum class ERotationMode : uint8_t
+	{
+		VelocityDirection,
+		LookingDirection,
+		Aiming
+	};
+
+	enum class EMovementDirection : uint8_t
+	{
+		Forward,
+		Right,
+		Left,
+		Backward
+	};
+
+	struct FVelocityBlend
+	{
+		float F = 0.0f;
+		float B = 0.0f;
+		float L = 0.0f;
+		float R = 0.0f;
+	};
+
+	inline float Clamp(float Value, float Min, float Max)
+	{
+		return Value < Min ? Min : (Value > Max ? Max : Value);
+	}
+
+	/** Same as FMath::GetMappedRangeValueClamped */
+	inline float MapRangeClamped(float InMin, float InMax, float OutMin, float OutMax, float Value)
+	{
+		const float Divisor = InMax - InMin;
+		const float Alpha = std::fabs(Divisor) <= 1.e-8f
+			                    ? (Value >= InMax ? 1.0f : 0.0f)
+			                    : Clamp((Value - InMin) / Divisor, 0.0f, 1.0f);
+		return OutMin + Alpha * (OutMax - OutMin);
+	}
+
+	/** Same as FRotator::NormalizeAxis, wraps the angle to (-180, 180] */
+	inline float NormalizeAxis(float Angle)
+	{
+		Angle = std::fmod(Angle, 360.0f);
+		if (Angle < 0.0f)
+		{
+			Angle += 360.0f;
+		}
+		return Angle > 180.0f ? Angle - 360.0f : Angle;
+	}
+
+	inline bool AngleInRange(float Angle, float MinAngle, float MaxAngle, float Buffer, bool bIncreaseBuffer)
+	{
+		if (bIncreaseBuffer)
+		{
+			return Angle >= MinAngle - Buffer && Angle <= MaxAngle + Buffer;
+		}
+		return Angle >= MinAngle + Buffer && Angle <= MaxAngle - Buffer;
+	}
+
+	inline EMovementDirection CalculateQuadrant(EMovementDirection Current, float FRThreshold, float FLThreshold,
+	                                            float BRThreshold, float BLThreshold, float Buffer, float Angle)
+	{
+		// Take the input angle and determine its quadrant (direction). Use the current Movement Direction to increase or
+		// decrease the buffers on the angle ranges for each quadrant.
+		const bool bForwardOrBackward = Current == EMovementDirection::Forward ||
+			Current == EMovementDirection::Backward;
+		const bool bRightOrLeft = Current == EMovementDirection::Right || Current == EMovementDirection::Left;
+
+		if (AngleInRange(Angle, FLThreshold, FRThreshold, Buffer, !bForwardOrBackward))
+		{
+			return EMovementDirection::Forward;
+		}
+
+		if (AngleInRange(Angle, FRThreshold, BRThreshold, Buffer, !bRightOrLeft))
+		{
+			return EMovementDirection::Right;
+		}
+
+		if (AngleInRange(Angle, BLThreshold, FLThreshold, Buffer, !bRightOrLeft))
+		{
+			return EMovementDirection::Left;
+		}
+
+		return EMovementDirection::Backward;
+	}
+
+	/**
+	 * Movement direction relative to the camera. VelocityAimYawDelta is the normalized yaw delta between
+	 * the velocity and the aiming rotation.
+	 */
+	inline EMovementDirection CalculateMovementDirection(EMovementDirection Current, EGait Gait,
+	                                                     ERotationMode RotationMode, float VelocityAimYawDelta)
+	{
+		if (Gait == EGait::Sprinting || RotationMode == ERotationMode::VelocityDirection)
+		{
+			return EMovementDirection::Forward;
+		}
+
+		return CalculateQuadrant(Current, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, VelocityAimYawDelta);
+	}
+
+	/**
+	 * Whether the character can sprint. InputAimYawDelta is the normalized yaw delta between the movement input
+	 * and the aiming rotation.
+	 */
+	inline bool CanSprint(bool bHasMovementInput, float MovementInputAmount, ERotationMode RotationMode,
+	                      float InputAimYawDelta)
+	{
+		if (!bHasMovementInput || RotationMode == ERotationMode::Aiming)
+		{
+			return false;
+		}
+
+		const bool bValidInputAmount = MovementInputAmount > 0.9f;
+
+		if (RotationMode == ERotationMode::VelocityDirection)
+		{
+			return bValidInputAmount;
+		}
+
+		return bValidInputAmount && std::fabs(InputAimYawDelta) < 50.0f;
+	}
+
+	inline EGait GetAllowedGait(EStance Stance, ERotationMode RotationMode, EGait DesiredGait, bool bCanSprint)
+	{
+		if (Stance == EStance::Standing && RotationMode != ERotationMode::Aiming)
+		{
+			if (DesiredGait == EGait::Sprinting)
+			{
+				return bCanSprint ? EGait::Sprinting : EGait::Running;
+			}
+			return DesiredGait;
+		}
+
+		// Crouching stance & Aiming rot mode has same behaviour
+		return DesiredGait == EGait::Sprinting ? EGait::Running : DesiredGait;
+	}
+
+	inline EGait GetActualGait(EGait AllowedGait, float Speed, float WalkSpeed, float RunSpeed)
+	{
+		if (Speed > RunSpeed + 10.0f)
+		{
+			return AllowedGait == EGait::Sprinting ? EGait::Sprinting : EGait::Running;
+		}
+
+		if (Speed >= WalkSpeed + 10.0f)
+		{
+			return EGait::Running;
+		}
+
+		return EGait::Walking;
+	}
+
+	/** Map the speed to a range of 0-3, with 0 = stopped, 1 = walk speed, 2 = run speed and 3 = sprint speed */
+	inline float GetMappedSpeed(float Speed, float WalkSpeed, float RunSpeed, float SprintSpeed)
+	{
+		if (Speed > RunSpeed)
+		{
+			return MapRangeClamped(RunSpeed, SprintSpeed, 2.0f, 3.0f, Speed);
+		}
+
+		if (Speed > WalkSpeed)
+		{
+			return MapRangeClamped(WalkSpeed, RunSpeed, 1.0f, 2.0f, Speed);
+		}
+
+		return MapRangeClamped(0.0f, WalkSpeed, 0.0f, 1.0f, Speed);
+	}
+
+	/** RotationRateCurveValue is the value of the rotation rate curve at the mapped speed */
+	inline float CalculateGroundedRotationRate(float RotationRateCurveValue, float AimYawRate)
+	{
+		return RotationRateCurveValue * MapRangeClamped(0.0f, 300.0f, 1.0f, 3.0f, AimYawRate);
+	}
+
+	/**
+	 * Velocity amount in each direction, normalized so that diagonals equal .5 for each direction.
+	 * Takes the normalized velocity direction relative to the actor rotation.
+	 */
+	inline FVelocityBlend CalculateVelocityBlend(float RelativeDirX, float RelativeDirY, float RelativeDirZ)
+	{
+		const float Sum = std::fabs(RelativeDirX) + std::fabs(RelativeDirY) + std::fabs(RelativeDirZ);
+		FVelocityBlend Result;
+		if (Sum <= 0.0f)
+		{
+			return Result;
+		}
+
+		const float X = RelativeDirX / Sum;
+		const float Y = RelativeDirY / Sum;
+		Result.F = Clamp(X, 0.0f, 1.0f);
+		Result.B = std::fabs(Clamp(X, -1.0f, 0.0f));
+		Result.L = std::fabs(Clamp(Y, -1.0f, 0.0f));
+		Result.R = Clamp(Y, 0.0f, 1.0f);
+		return Result;
+	}
+}
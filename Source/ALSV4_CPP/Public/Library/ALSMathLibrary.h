@@ -55,4 +55,30 @@ public:
 	static EALSMovementDirection CalculateQuadrant(EALSMovementDirection Current, float FRThreshold, float FLThreshold,
 	                                               float BRThreshold,
 	                                               float BLThreshold, float Buffer, float Angle);
+
+	/** Batch Utils. Each array element belongs to one character, inputs are processed four characters at a time */
+
+	/** Normalized (A - B) yaw deltas in (-180, 180] range */
+	static void CalculateYawDeltas(TArrayView<const float> YawsA, TArrayView<const float> YawsB,
+	                               TArrayView<float> OutDeltas);
+
+	/** Batch version of CalculateQuadrant, Directions are used as the current directions and updated in place */
+	static void CalculateQuadrants(TArrayView<EALSMovementDirection> Directions, TArrayView<const float> Angles,
+	                               float FRThreshold, float FLThreshold, float BRThreshold, float BLThreshold,
+	                               float Buffer);
+
+	/** Velocity blend amounts of world space velocities relative to the actor yaws */
+	static void CalculateVelocityBlends(TArrayView<const float> VelocitiesX, TArrayView<const float> VelocitiesY,
+	                                    TArrayView<const float> VelocitiesZ, TArrayView<const float> ActorYaws,
+	                                    TArrayView<float> OutF, TArrayView<float> OutB, TArrayView<float> OutL,
+	                                    TArrayView<float> OutR);
+
+	/**
+	 * Interpolate lean amounts towards the relative acceleration amounts of world space accelerations. MaxAccelerations
+	 * should hold max acceleration or max braking deceleration of each character, depending on if it's accelerating
+	 */
+	static void InterpLeanAmounts(TArrayView<const float> AccelerationsX, TArrayView<const float> AccelerationsY,
+	                              TArrayView<const float> ActorYaws, TArrayView<const float> MaxAccelerations,
+	                              TArrayView<float> InOutLR, TArrayView<float> InOutFB, float DeltaTime,
+	                              float InterpSpeed);
 };
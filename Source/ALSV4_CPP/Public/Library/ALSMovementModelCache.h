@@ -0,0 +1,55 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+/**
+ * Immutable copy of one movement model data table row, shared by every character using the same row
+ */
+struct ALSV4_CPP_API FALSMovementModel
+{
+	/* One settings entry per rotation mode and stance */
+	static constexpr int32 NumSettings = 6;
+
+	explicit FALSMovementModel(const FALSMovementStateSettings& InSettings);
+
+	FALSMovementModel(const FALSMovementModel&) = delete;
+	FALSMovementModel& operator=(const FALSMovementModel&) = delete;
+
+	/** Index of the settings used for a rotation mode and stance, precomputed by characters on state changes */
+	static int32 GetSettingsIndex(EALSRotationMode RotationMode, EALSStance Stance);
+
+	const FALSMovementSettings& GetSettings(int32 SettingsIndex) const
+	{
+		return *SettingsByIndex[FMath::Clamp(SettingsIndex, 0, NumSettings - 1)];
+	}
+
+	const FALSMovementStateSettings Settings;
+
+private:
+	const FALSMovementSettings* SettingsByIndex[NumSettings];
+};
+
+/**
+ * Resolves movement model rows once per data table and row name. Entries are refcounted by the characters
+ * holding them and dropped once the last one goes away. Changing a cached data table (editor edits,
+ * reimports or runtime row changes) invalidates its entries and notifies characters to resolve again.
+ */
+class ALSV4_CPP_API FALSMovementModelCache
+{
+public:
+	/** Shared model of the row, nullptr if the handle doesn't point to a movement model row */
+	static TSharedPtr<const FALSMovementModel> Get(const FDataTableRowHandle& Handle);
+
+	/** Broadcast with the changed data table after its cached models were invalidated */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnMovementModelsInvalidated, const UDataTable*);
+	static FOnMovementModelsInvalidated& OnMovementModelsInvalidated();
+
+private:
+	static void OnDataTableChanged(TWeakObjectPtr<const UDataTable> DataTable);
+};
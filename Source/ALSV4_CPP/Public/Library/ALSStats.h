@@ -0,0 +1,94 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+#include <atomic>
+
+DECLARE_STATS_GROUP(TEXT("ALS"), STATGROUP_ALS, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Foot IK Traces"), STAT_ALS_FootIKTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Land Prediction Traces"), STAT_ALS_LandPredictionTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Camera Traces"), STAT_ALS_CameraTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Mantle Traces"), STAT_ALS_MantleTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ragdoll Traces"), STAT_ALS_RagdollTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Footstep Traces"), STAT_ALS_FootstepTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Traces"), STAT_ALS_DeferredTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Reused Traces"), STAT_ALS_ReusedTraces, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Probes"), STAT_ALS_GroundProbes, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Shared Ground Probes"), STAT_ALS_SharedGroundProbes, STATGROUP_ALS, ALSV4_CPP_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Full Ragdolls"), STAT_ALS_FullRagdolls, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Reduced Ragdolls"), STAT_ALS_ReducedRagdolls, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Simple Ragdolls"), STAT_ALS_SimpleRagdolls, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Settled Ragdolls"), STAT_ALS_SettledRagdolls, STATGROUP_ALS, ALSV4_CPP_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("High Significance AI"), STAT_ALS_HighSignificanceAI, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Medium Significance AI"), STAT_ALS_MediumSignificanceAI, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Low Significance AI"), STAT_ALS_LowSignificanceAI, STATGROUP_ALS, ALSV4_CPP_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Crowd Agents"), STAT_ALS_CrowdAgents, STATGROUP_ALS, ALSV4_CPP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Hydrated Crowd Agents"), STAT_ALS_HydratedCrowdAgents, STATGROUP_ALS, ALSV4_CPP_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ALSV4_CPP_API, ALS);
+
+#define ALS_STAGE_TIMINGS !UE_BUILD_SHIPPING
+
+/* Stages the ALS benchmarks time separately, stages can nest*/
+enum class EALSStage : uint8
+{
+	CharacterTick,
+	AnimUpdate,
+	MovementComponent,
+	Mantle,
+	Footsteps,
+	AI,
+	Ragdoll,
+	MAX
+};
+
+#if ALS_STAGE_TIMINGS
+/*
+ * Time spent in each stage, collected only while enabled. Unlike stats these can be read back in any
+ * non shipping build, so benchmarks can write them out themselves.
+ */
+namespace ALSStageTimings
+{
+	extern ALSV4_CPP_API std::atomic<bool> bEnabled;
+
+	ALSV4_CPP_API void AddCycles(EALSStage Stage, uint64 Cycles);
+
+	ALSV4_CPP_API double GetSeconds(EALSStage Stage);
+
+	ALSV4_CPP_API void Reset();
+
+	struct FScope
+	{
+		explicit FScope(EALSStage InStage)
+			: Stage(InStage), StartCycles(bEnabled.load(std::memory_order_relaxed) ? FPlatformTime::Cycles64() : 0)
+		{
+		}
+
+		~FScope()
+		{
+			if (StartCycles != 0)
+			{
+				AddCycles(Stage, FPlatformTime::Cycles64() - StartCycles);
+			}
+		}
+
+	private:
+		EALSStage Stage;
+		uint64 StartCycles;
+	};
+}
+
+#define ALS_SCOPED_STAGE_TIMING(Stage) \
+	const ALSStageTimings::FScope PREPROCESSOR_JOIN(ALSStageTiming_, __LINE__)(EALSStage::Stage)
+#else
+#define ALS_SCOPED_STAGE_TIMING(Stage)
+#endif
@@ -0,0 +1,56 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+class AActor;
+
+/** Kind of ALS state transition written to the "ALS" trace channel */
+enum class EALSTraceTransition : uint8
+{
+	MovementState,
+	Gait,
+	Stance,
+	RotationMode,
+	OverlayState,
+	MantleStart,
+	MantleEnd,
+	RagdollStart,
+	RagdollEnd
+};
+
+UE_TRACE_CHANNEL_EXTERN(ALSChannel, ALSV4_CPP_API)
+
+namespace ALSTrace
+{
+	/* Set by "ALS.Trace.RecordTransitions", keeps a ring buffer for "ALS.Trace.DumpTransitions" */
+	extern ALSV4_CPP_API bool bRecordTransitions;
+
+	FORCEINLINE bool IsEnabled()
+	{
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(ALSChannel) || bRecordTransitions
+#if CSV_PROFILER
+			|| FCsvProfiler::Get()->IsCapturing()
+#endif
+			;
+	}
+
+	ALSV4_CPP_API void OutputStateTransition(const AActor* Actor, EALSTraceTransition Kind, uint8 OldValue, uint8 NewValue);
+
+	/** Write the recorded transitions to Saved/Profiling/ALS as CSV, returns the written file or an empty string */
+	ALSV4_CPP_API FString DumpTransitionsToCsv();
+}
+
+/** Cheap to leave in when nothing listens: one channel check and two flag loads */
+#define ALS_TRACE_STATE_TRANSITION(Actor, Kind, OldValue, NewValue) \
+	do \
+	{ \
+		if (ALSTrace::IsEnabled()) \
+		{ \
+			ALSTrace::OutputStateTransition(Actor, Kind, static_cast<uint8>(OldValue), static_cast<uint8>(NewValue)); \
+		} \
+	} while (0)
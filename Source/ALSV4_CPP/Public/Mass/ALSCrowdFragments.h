@@ -0,0 +1,94 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSCrowdFragments.generated.h"
+
+class AALSBaseCharacter;
+struct FALSMovementModel;
+
+/**
+ * Crowd agent location and rotation. Crowd agents only rotate around the yaw axis
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSCrowdTransformFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Location = FVector::ZeroVector;
+
+	float Yaw = 0.0f;
+
+	/* Interpolated rotation target, same as the TargetRotation of the character*/
+	float TargetYaw = 0.0f;
+};
+
+/**
+ * Essential movement values of a crowd agent, mirroring the ones of the character
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSCrowdMovementFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Velocity = FVector::ZeroVector;
+
+	/* Movement intent on the XY plane, its length is the input amount*/
+	FVector MovementInput = FVector::ZeroVector;
+
+	float Speed = 0.0f;
+
+	float LastVelocityYaw = 0.0f;
+
+	/* Yaw the agent looks at in looking direction and aiming rotation modes*/
+	float AimYaw = 0.0f;
+};
+
+USTRUCT()
+struct ALSV4_CPP_API FALSCrowdStateFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	EALSMovementState MovementState = EALSMovementState::Grounded;
+
+	EALSGait Gait = EALSGait::Walking;
+
+	EALSGait DesiredGait = EALSGait::Running;
+
+	EALSStance Stance = EALSStance::Standing;
+
+	EALSRotationMode RotationMode = EALSRotationMode::VelocityDirection;
+
+	EALSOverlayState OverlayState = EALSOverlayState::Default;
+};
+
+/**
+ * Character class and movement model of a crowd agent, and the actor representing it while hydrated
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSCrowdAgentFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/* Shared through the movement model cache. Agents keep the model they were spawned with*/
+	TSharedPtr<const FALSMovementModel> MovementModel;
+
+	/* Referenced by the crowd subsystem*/
+	UClass* CharacterClass = nullptr;
+
+	TWeakObjectPtr<AALSBaseCharacter> Actor;
+};
+
+/**
+ * Agents represented by a character actor. Their values are copied from the actor instead of being simulated
+ */
+USTRUCT()
+struct ALSV4_CPP_API FALSCrowdHydratedTag : public FMassTag
+{
+	GENERATED_BODY()
+};
@@ -0,0 +1,51 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+
+#include "ALSCrowdProcessors.generated.h"
+
+/**
+ * Gait and ground movement of dehydrated crowd agents, same gait rules as AALSBaseCharacter::UpdateCharacterMovement
+ * and the same movement curves as UALSCharacterMovementComponent. Chunks are processed in parallel
+ */
+UCLASS()
+class ALSV4_CPP_API UALSCrowdGaitProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UALSCrowdGaitProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * Grounded rotation of dehydrated crowd agents, same rules as AALSBaseCharacter::UpdateGroundedRotation
+ * without the animation driven turn in place. Chunks are processed in parallel
+ */
+UCLASS()
+class ALSV4_CPP_API UALSCrowdRotationProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UALSCrowdRotationProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
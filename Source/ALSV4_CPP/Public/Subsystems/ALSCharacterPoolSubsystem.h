@@ -0,0 +1,72 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSCharacterStructLibrary.h"
+
+#include "ALSCharacterPoolSubsystem.generated.h"
+
+class AALSBaseCharacter;
+
+USTRUCT()
+struct FALSPooledCharacters
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AALSBaseCharacter>> Characters;
+};
+
+/**
+ * Keeps released ALS characters deactivated in the world and hands them out again instead of spawning new ones.
+ * Reused characters skip component construction, BeginPlay and anim instance initialization, and are brought
+ * back to their spawn state with ResetALSState.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSCharacterPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Reactivate a pooled character of the given class at the transform, or spawn a new one if none is pooled */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Character Pool", meta = (DeterminesOutputType = "CharacterClass"))
+	AALSBaseCharacter* AcquireCharacter(TSubclassOf<AALSBaseCharacter> CharacterClass, const FTransform& Transform);
+
+	/** Deactivate the character and keep it for a later AcquireCharacter call */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Character Pool")
+	void ReleaseCharacter(AALSBaseCharacter* Character);
+
+	/** Spawn characters up front so the first wave doesn't pay the spawn cost */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Character Pool")
+	void Prewarm(TSubclassOf<AALSBaseCharacter> CharacterClass, int32 Count);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Character Pool")
+	int32 GetNumPooled(TSubclassOf<AALSBaseCharacter> CharacterClass) const;
+
+	/** Spawn and reuse counts with their average cost, to compare both paths on the same workload */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Character Pool")
+	FALSCharacterPoolStats GetPoolStats() const;
+
+	/** Maximum amount of released characters kept per class, further ones are destroyed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Character Pool")
+	int32 MaxPooledPerClass = 64;
+
+private:
+	AALSBaseCharacter* SpawnCharacter(UClass* CharacterClass, const FTransform& Transform);
+
+	static void SetCharacterActive(AALSBaseCharacter* Character, bool bActive);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FALSPooledCharacters> Pools;
+
+	FALSCharacterPoolStats Stats;
+
+	double TotalSpawnSeconds = 0.0;
+
+	double TotalReuseSeconds = 0.0;
+};
@@ -0,0 +1,137 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "MassProcessingTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSCrowdSubsystem.generated.h"
+
+class AALSBaseCharacter;
+struct FMassEntityManager;
+
+/**
+ * Simulates large crowds of ALS agents as Mass entities, with the gait and rotation rules of the character running
+ * in parallel on worker threads. Agents close to a viewer are hydrated into pooled ALS characters, which carry
+ * on from the agent state and copy their own state back until they are dehydrated again.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Create a dehydrated agent using the movement model of the character class */
+	FMassEntityHandle SpawnAgent(TSubclassOf<AALSBaseCharacter> CharacterClass, const FTransform& Transform);
+
+	/** Destroy the agent, releasing its character if hydrated */
+	void DestroyAgent(FMassEntityHandle Agent);
+
+	/** Movement intent of the agent on the XY plane, forwarded to its character while hydrated */
+	void SetAgentMovementInput(FMassEntityHandle Agent, const FVector& MovementInput, float AimYaw,
+	                           EALSGait DesiredGait);
+
+	void SetAgentStates(FMassEntityHandle Agent, EALSStance Stance, EALSRotationMode RotationMode,
+	                    EALSOverlayState OverlayState);
+
+	/** Character representing the agent, nullptr while dehydrated */
+	AALSBaseCharacter* GetAgentActor(FMassEntityHandle Agent) const;
+
+	const TArray<FMassEntityHandle>& GetAgents() const { return Agents; }
+
+	/** Replace the agent with a pooled character carrying on from its state, regardless of the viewer distance */
+	bool HydrateAgent(FMassEntityHandle Agent);
+
+	/**
+	 * Return the character of the agent to the pool and continue simulating the agent from the character state.
+	 * Returns false if the character is in a state the agent can't continue, e.g. ragdoll or mantling
+	 */
+	bool DehydrateAgent(FMassEntityHandle Agent);
+
+	/** Spawn an agent per transform, returns the amount of agents created */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Crowd")
+	int32 SpawnCrowd(TSubclassOf<AALSBaseCharacter> CharacterClass, const TArray<FTransform>& Transforms);
+
+	/** Run one crowd simulation step. Called by Tick if bAutoSimulate is set, and can be stepped manually in headless runs */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Crowd")
+	void Simulate(float DeltaTime);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Crowd")
+	int32 GetNumAgents() const { return Agents.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Crowd")
+	int32 GetNumHydratedAgents() const { return HydratedAgents.Num(); }
+
+public:
+	/** Simulate the crowd on every world tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd")
+	bool bAutoSimulate = true;
+
+	/** Replace agents close to a viewer with ALS characters */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd")
+	bool bEnableHydration = true;
+
+	/** Agents closer than this distance to a viewer are hydrated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd", meta = (EditCondition = "bEnableHydration"))
+	float HydrationDistance = 3000.0f;
+
+	/** Hydrated agents further than this distance from every viewer are dehydrated, prevents swapping on the boundary */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd", meta = (EditCondition = "bEnableHydration"))
+	float DehydrationDistance = 3500.0f;
+
+	/** Maximum amount of simultaneous hydrated agents. Closest ones are hydrated first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd", meta = (EditCondition = "bEnableHydration"))
+	int32 MaxHydratedAgents = 32;
+
+	/** Maximum amount of agents hydrated per update, spreads the character activation cost over frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd", meta = (EditCondition = "bEnableHydration"))
+	int32 MaxHydrationsPerUpdate = 4;
+
+	/** Interval in seconds between re-evaluating hydration */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd", meta = (EditCondition = "bEnableHydration"))
+	float HydrationUpdateInterval = 0.25f;
+
+	/**
+	 * Agents only move on the XY plane, so the ground is traced this far above and below an agent before it is
+	 * hydrated, and the character is placed on it
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Crowd", meta = (EditCondition = "bEnableHydration"))
+	float HydrationGroundTraceDistance = 500.0f;
+
+private:
+	FMassEntityManager& GetEntityManager() const;
+
+	/* Forward agent intent to the hydrated characters and copy their state back*/
+	void SyncHydratedAgents();
+
+	void UpdateHydration();
+
+	void CopyCharacterState(FMassEntityHandle Agent, const AALSBaseCharacter& Character) const;
+
+	FMassArchetypeHandle AgentArchetype;
+
+	UPROPERTY()
+	FMassRuntimePipeline Pipeline;
+
+	/* Character classes referenced by agent fragments*/
+	UPROPERTY()
+	TArray<TObjectPtr<UClass>> AgentClasses;
+
+	TArray<FMassEntityHandle> Agents;
+
+	TArray<FMassEntityHandle> HydratedAgents;
+
+	float TimeSinceHydrationUpdate = 0.0f;
+};
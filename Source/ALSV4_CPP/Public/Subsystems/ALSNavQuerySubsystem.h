@@ -0,0 +1,97 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ALSNavQuerySubsystem.generated.h"
+
+class ANavigationData;
+
+DECLARE_DELEGATE_TwoParams(FALSRandomLocationDelegate, bool /*bSuccess*/, const FVector& /*Location*/);
+
+/**
+ * Runs random reachable point queries for ALS AI within a per frame budget instead of on request, so hundreds of
+ * agents repicking destinations in the same frame don't spike the game thread. Resolved query filters are cached
+ * per navigation data, and reachable points can be pooled per region for agents to draw from.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSNavQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Queue a random reachable point query around Origin. The callback runs on the game thread once the query
+	 * ran, or not at all if the request is cancelled. Returns the request id used for cancelling.
+	 */
+	uint32 RequestRandomReachablePoint(const FVector& Origin, float Radius, TSubclassOf<UNavigationQueryFilter> Filter,
+	                                   bool bAddToPointPool, FALSRandomLocationDelegate Callback);
+
+	void CancelRequest(uint32 RequestId);
+
+	/** Draw a random pooled point within Radius of Origin, false if the region pool isn't filled yet */
+	bool TryGetPooledPoint(const FVector& Origin, float Radius, TSubclassOf<UNavigationQueryFilter> Filter,
+	                       FVector& OutLocation);
+
+	/** Query filter of the class for the nav data, resolved once and reused */
+	FSharedConstNavQueryFilter GetQueryFilter(const ANavigationData& NavData, TSubclassOf<UNavigationQueryFilter> Filter);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Navigation")
+	int32 GetNumPendingRequests() const { return PendingRequests.Num(); }
+
+	/** Maximum amount of navigation queries executed per frame, further requests wait for the next frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Navigation", meta = (ClampMin = 1))
+	int32 MaxQueriesPerFrame = 16;
+
+	/** Size of the regions reachable points are pooled in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Navigation", meta = (ClampMin = 100.0f))
+	float PointPoolCellSize = 2000.0f;
+
+	/** Points needed in a region before agents draw from it instead of querying */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Navigation", meta = (ClampMin = 1))
+	int32 PointPoolSize = 32;
+
+	/** Seconds after which a region pool is sampled again, so nav mesh changes are picked up */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Navigation", meta = (ClampMin = 0.0f))
+	float PointPoolLifetime = 30.0f;
+
+private:
+	struct FRequest
+	{
+		uint32 Id = 0;
+		FVector Origin = FVector::ZeroVector;
+		float Radius = 0.0f;
+		TSubclassOf<UNavigationQueryFilter> Filter;
+		bool bAddToPointPool = false;
+		FALSRandomLocationDelegate Callback;
+	};
+
+	struct FPointPool
+	{
+		TArray<FVector> Points;
+		double CreationTime = 0.0;
+	};
+
+	using FPointPoolKey = TPair<UClass*, FIntPoint>;
+
+	FPointPoolKey GetPointPoolKey(const FVector& Location, TSubclassOf<UNavigationQueryFilter> Filter) const;
+
+	void AddPooledPoint(const FVector& Origin, TSubclassOf<UNavigationQueryFilter> Filter, const FVector& Point);
+
+	TArray<FRequest> PendingRequests;
+
+	/* Resolved filters, keyed by nav data and filter class */
+	TMap<TPair<TWeakObjectPtr<const ANavigationData>, UClass*>, FSharedConstNavQueryFilter> QueryFilters;
+
+	TMap<FPointPoolKey, FPointPool> PointPools;
+
+	uint32 NextRequestId = 1;
+};
@@ -0,0 +1,71 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSRagdollLODSubsystem.generated.h"
+
+class AALSBaseCharacter;
+
+/**
+ * Assigns ragdoll LOD tiers to active ragdolls by their distance to the closest viewer,
+ * and limits the amount of simultaneous full ragdolls
+ */
+UCLASS()
+class ALSV4_CPP_API UALSRagdollLODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/** Registers a starting ragdoll and returns the initial LOD it should use */
+	EALSRagdollLOD RegisterRagdoll(AALSBaseCharacter* Character);
+
+	void UnregisterRagdoll(AALSBaseCharacter* Character);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Ragdoll LOD")
+	int32 GetNumActiveRagdolls() const { return ActiveRagdolls.Num(); }
+
+public:
+	/** Ragdolls closer than this distance to a viewer use the full physics asset */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Ragdoll LOD")
+	float FullDistance = 1500.0f;
+
+	/** Ragdolls closer than this distance to a viewer use the reduced physics asset, further ones use the simple one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Ragdoll LOD")
+	float ReducedDistance = 4000.0f;
+
+	/** Extra distance a ragdoll needs to move away before being demoted, prevents tier flickering */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Ragdoll LOD")
+	float DistanceBuffer = 250.0f;
+
+	/** Maximum amount of simultaneous full ragdolls. Closest ones are promoted first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Ragdoll LOD")
+	int32 MaxFullRagdolls = 8;
+
+	/** Interval in seconds between re-evaluating tiers of active ragdolls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|Ragdoll LOD")
+	float UpdateInterval = 0.25f;
+
+private:
+	void GatherViewLocations();
+
+	float GetClosestViewDistanceSquared(const FVector& Location) const;
+
+	EALSRagdollLOD GetDesiredLOD(EALSRagdollLOD CurrentLOD, float DistanceSquared) const;
+
+	void UpdateRagdollLODs();
+
+	TArray<TWeakObjectPtr<AALSBaseCharacter>> ActiveRagdolls;
+
+	TArray<FVector> ViewLocations;
+
+	float TimeSinceLastUpdate = 0.0f;
+};
@@ -0,0 +1,148 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+#include "Library/ALSCharacterStructLibrary.h"
+#include "UObject/ObjectKey.h"
+
+#include "ALSSceneQuerySubsystem.generated.h"
+
+/**
+ * Shared per frame budget for ALS scene queries. Each query has a priority by its type and the significance of its
+ * owner. Low priority queries over the budget are deferred for up to MaxDeferredFrames, and answered with the last
+ * result of the same query moved along with the query.
+ *
+ * Tuned in the [/Script/ALSV4_CPP.ALSSceneQuerySubsystem] section of DefaultGame.ini.
+ */
+UCLASS(Config = Game)
+class ALSV4_CPP_API UALSSceneQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UALSSceneQuerySubsystem();
+
+	/** Line trace through the query budget of the world, runs the trace directly if the world has no ALS query subsystem */
+	static bool LineTraceSingleByChannel(const UWorld* World, EALSSceneQueryType QueryType, const AActor* Owner,
+	                                     int32 QueryKey, FHitResult& OutHit, const FVector& Start, const FVector& End,
+	                                     ECollisionChannel TraceChannel, const FCollisionQueryParams& Params);
+
+	/** Sweep through the query budget of the world, runs the sweep directly if the world has no ALS query subsystem */
+	static bool SweepSingleByChannel(const UWorld* World, EALSSceneQueryType QueryType, const AActor* Owner,
+	                                 int32 QueryKey, FHitResult& OutHit, const FVector& Start, const FVector& End,
+	                                 ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape,
+	                                 const FCollisionQueryParams& Params);
+
+	/** Sweep through the query budget of the world, runs the sweep directly if the world has no ALS query subsystem */
+	static bool SweepSingleByProfile(const UWorld* World, EALSSceneQueryType QueryType, const AActor* Owner,
+	                                 int32 QueryKey, FHitResult& OutHit, const FVector& Start, const FVector& End,
+	                                 FName ProfileName, const FCollisionShape& CollisionShape,
+	                                 const FCollisionQueryParams& Params);
+
+	/**
+	 * Downward line trace shared between ALS systems. Probes of the same owner with the same channel, query params and
+	 * XY cell reuse each other's result in the same frame, if the previous probe covered the requested height range.
+	 * Only executed traces are shared, non vertical traces are passed to the line trace.
+	 */
+	static bool ProbeGround(const UWorld* World, EALSSceneQueryType QueryType, const AActor* Owner, int32 QueryKey,
+	                        FHitResult& OutHit, const FVector& Start, const FVector& End,
+	                        ECollisionChannel TraceChannel, const FCollisionQueryParams& Params);
+
+	/**
+	 * Query params of ground probes: complex, returning the physical material and ignoring the owner with its
+	 * attached actors. Probes need the same params and channel to share their results.
+	 */
+	static FCollisionQueryParams MakeGroundProbeParams(const AActor* Owner);
+
+	/** Channel of the ground probes of foot IK, ragdoll and the default footstep notify */
+	static constexpr ECollisionChannel GroundProbeChannel = ECC_Visibility;
+
+	/** Scale the priority of all queries owned by an actor, in (0, 1] range */
+	UFUNCTION(BlueprintCallable, Category = "ALS|Scene Query")
+	void SetSignificance(const AActor* Owner, float Significance);
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Scene Query")
+	FALSSceneQueryStats GetFrameStats() const { return FrameStats; }
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Scene Query")
+	FALSSceneQueryStats GetTotalStats() const { return TotalStats; }
+
+public:
+	/** Maximum amount of queries executed per frame. Camera, mantle and footstep queries are never deferred */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Scene Query", meta = (ClampMin = 0))
+	int32 MaxQueriesPerFrame = 256;
+
+	/**
+	 * Priority of each query type, 1 if not listed. Scaled by the significance of the owner, a query is deferred once
+	 * the executed queries of the frame exceed this share of the budget
+	 */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Scene Query")
+	TMap<EALSSceneQueryType, float> QueryPriorities;
+
+	/** A deferred query is executed regardless of the budget after this many frames */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Scene Query", meta = (ClampMin = 0))
+	int32 MaxDeferredFrames = 4;
+
+	/** Size of the XY cells ground probes are shared in */
+	UPROPERTY(Config, BlueprintReadWrite, Category = "ALS|Scene Query", meta = (ClampMin = 0.1))
+	float GroundProbeCellSize = 5.0f;
+
+private:
+	struct FQueryResult
+	{
+		FHitResult Hit;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		uint64 Frame = 0;
+		bool bHit = false;
+	};
+
+	using FQueryId = TTuple<FObjectKey, EALSSceneQueryType, int32>;
+
+	struct FGroundProbe
+	{
+		FHitResult Hit;
+		float StartZ = 0.0f;
+		float EndZ = 0.0f;
+		bool bHit = false;
+		bool bReturnPhysicalMaterial = false;
+	};
+
+	/* Owner, channel, complex trace, ignored actors and components and XY cell of a ground probe*/
+	using FGroundProbeId = TTuple<FObjectKey, ECollisionChannel, bool, uint32, FIntPoint>;
+
+	static uint32 GetIgnoredHash(const FCollisionQueryParams& Params);
+
+	bool FindGroundProbe(const FGroundProbeId& ProbeId, const FVector& Start, const FVector& End,
+	                     const FCollisionQueryParams& Params, FHitResult& OutHit, bool& bOutHit) const;
+
+	/* bOutExecuted is false if the query was answered with a previous result*/
+	template <typename QueryFunc>
+	bool RunQuery(EALSSceneQueryType QueryType, const AActor* Owner, int32 QueryKey, FHitResult& OutHit,
+	              const FVector& Start, const FVector& End, QueryFunc&& Query, bool* bOutExecuted = nullptr);
+
+	/* Last result of a deferred query, moved by the offset between the query and the traced start*/
+	static void MoveResult(const FQueryResult& Result, const FVector& Start, const FVector& End, FHitResult& OutHit,
+	                       bool& bOutHit);
+
+	void BeginFrame();
+
+	float GetPriority(EALSSceneQueryType QueryType, const AActor* Owner) const;
+
+	TMap<FQueryId, FQueryResult> Results;
+
+	TMap<FObjectKey, float> Significances;
+
+	/* Ground probes of the current frame*/
+	TMap<FGroundProbeId, FGroundProbe> GroundProbes;
+
+	FALSSceneQueryStats FrameStats;
+
+	FALSSceneQueryStats TotalStats;
+
+	uint64 CurrentFrame = 0;
+};
@@ -0,0 +1,71 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Library/ALSCharacterEnumLibrary.h"
+
+#include "ALSTargetSubsystem.generated.h"
+
+/**
+ * Keeps ALS characters and player pawns in a 2D spatial hash for AI target selection. Targets only move between
+ * cells when they cross a cell border, and their focal points are cached once per frame for AI focus.
+ */
+UCLASS()
+class ALSV4_CPP_API UALSTargetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void RegisterTarget(APawn* Pawn);
+
+	void UnregisterTarget(APawn* Pawn);
+
+	/** Closest visible target of the given type within MaxDistance, ignoring Querier */
+	UFUNCTION(BlueprintCallable, Category = "ALS|AI")
+	APawn* FindNearestTarget(const FVector& Origin, float MaxDistance, EALSFocusTargetType TargetType,
+	                         const APawn* Querier) const;
+
+	/** Eye view location of a registered target cached this frame, falls back to a direct lookup otherwise */
+	FVector GetFocalPoint(const APawn* Pawn) const;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|AI")
+	int32 GetNumTargets() const { return Targets.Num(); }
+
+	/** Size of the spatial hash cells, roughly the common focus search distance works best */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS|AI", meta = (ClampMin = 100.0f))
+	float CellSize = 2000.0f;
+
+private:
+	struct FTarget
+	{
+		TWeakObjectPtr<APawn> Pawn;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		FVector Location = FVector::ZeroVector;
+		FVector FocalPoint = FVector::ZeroVector;
+		bool bIsPlayer = false;
+	};
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void AddToCell(int32 TargetIndex);
+
+	void RemoveFromCell(int32 TargetIndex);
+
+	void RemoveTargetAt(int32 TargetIndex);
+
+	void RegisterPlayerPawns();
+
+	TArray<FTarget> Targets;
+
+	/* Target indices per cell */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	TMap<TWeakObjectPtr<const APawn>, int32> TargetIndices;
+};
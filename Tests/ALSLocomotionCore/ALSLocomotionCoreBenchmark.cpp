@@ -0,0 +1,129 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Library/ALSLocomotionCore.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using namespace ALSLocomotionCore;
+
+namespace
+{
+	/* Locomotion inputs of one character, as the character and anim instance read them each frame*/
+	struct FCharacterInput
+	{
+		float Speed;
+		float VelocityAimYawDelta;
+		float InputAimYawDelta;
+		float RelativeDirX;
+		float RelativeDirY;
+		float MovementInputAmount;
+		ERotationMode RotationMode;
+		EStance Stance;
+	};
+
+	struct FCharacterOutput
+	{
+		EMovementDirection Direction = EMovementDirection::Forward;
+		EGait Gait = EGait::Walking;
+		float MappedSpeed = 0.0f;
+		FVelocityBlend VelocityBlend;
+	};
+
+	std::vector<FCharacterInput> MakeInputs(int64_t Count)
+	{
+		std::mt19937 Random(static_cast<uint32_t>(Count));
+		std::uniform_real_distribution<float> Angle(-180.0f, 180.0f);
+		std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+
+		std::vector<FCharacterInput> Inputs(static_cast<size_t>(Count));
+		for (FCharacterInput& Input : Inputs)
+		{
+			const float Direction = Angle(Random) * 3.14159265f / 180.0f;
+			Input.Speed = Unit(Random) * 700.0f;
+			Input.VelocityAimYawDelta = Angle(Random);
+			Input.InputAimYawDelta = Angle(Random);
+			Input.RelativeDirX = std::cos(Direction);
+			Input.RelativeDirY = std::sin(Direction);
+			Input.MovementInputAmount = Unit(Random);
+			Input.RotationMode = static_cast<ERotationMode>(Random() % 3);
+			Input.Stance = static_cast<EStance>(Random() % 2);
+		}
+		return Inputs;
+	}
+
+	/* Locomotion state of every character for one frame, the per character work of the ALS character and anim update*/
+	void BM_UpdateLocomotion(benchmark::State& State)
+	{
+		const std::vector<FCharacterInput> Inputs = MakeInputs(State.range(0));
+		std::vector<FCharacterOutput> Outputs(Inputs.size());
+
+		for (auto _ : State)
+		{
+			for (size_t Index = 0; Index < Inputs.size(); ++Index)
+			{
+				const FCharacterInput& In = Inputs[Index];
+				FCharacterOutput& Out = Outputs[Index];
+
+				const bool bCanSprint = CanSprint(In.MovementInputAmount > 0.0f, In.MovementInputAmount,
+				                                  In.RotationMode, In.InputAimYawDelta);
+				const EGait AllowedGait = GetAllowedGait(In.Stance, In.RotationMode, EGait::Sprinting, bCanSprint);
+				Out.Gait = GetActualGait(AllowedGait, In.Speed, 165.0f, 375.0f);
+				Out.MappedSpeed = GetMappedSpeed(In.Speed, 165.0f, 375.0f, 650.0f);
+				Out.Direction = CalculateMovementDirection(Out.Direction, Out.Gait, In.RotationMode,
+				                                           In.VelocityAimYawDelta);
+				Out.VelocityBlend = CalculateVelocityBlend(In.RelativeDirX, In.RelativeDirY, 0.0f);
+			}
+			benchmark::DoNotOptimize(Outputs.data());
+			benchmark::ClobberMemory();
+		}
+
+		State.SetItemsProcessed(State.iterations() * State.range(0));
+	}
+
+	void BM_CalculateQuadrant(benchmark::State& State)
+	{
+		const std::vector<FCharacterInput> Inputs = MakeInputs(State.range(0));
+		std::vector<EMovementDirection> Directions(Inputs.size(), EMovementDirection::Forward);
+
+		for (auto _ : State)
+		{
+			for (size_t Index = 0; Index < Inputs.size(); ++Index)
+			{
+				Directions[Index] = CalculateQuadrant(Directions[Index], 70.0f, -70.0f, 110.0f, -110.0f, 5.0f,
+				                                      Inputs[Index].VelocityAimYawDelta);
+			}
+			benchmark::DoNotOptimize(Directions.data());
+			benchmark::ClobberMemory();
+		}
+
+		State.SetItemsProcessed(State.iterations() * State.range(0));
+	}
+
+	void BM_NormalizeAxis(benchmark::State& State)
+	{
+		const std::vector<FCharacterInput> Inputs = MakeInputs(State.range(0));
+		std::vector<float> Deltas(Inputs.size());
+
+		for (auto _ : State)
+		{
+			for (size_t Index = 0; Index < Inputs.size(); ++Index)
+			{
+				Deltas[Index] = NormalizeAxis(Inputs[Index].VelocityAimYawDelta - Inputs[Index].InputAimYawDelta);
+			}
+			benchmark::DoNotOptimize(Deltas.data());
+			benchmark::ClobberMemory();
+		}
+
+		State.SetItemsProcessed(State.iterations() * State.range(0));
+	}
+}
+
+// Items per second are characters per second, the 1000 character runs give the time per 1k characters
+BENCHMARK(BM_UpdateLocomotion)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_CalculateQuadrant)->Arg(1000)->Arg(10000);
+BENCHMARK(BM_NormalizeAxis)->Arg(1000)->Arg(10000);
@@ -0,0 +1,136 @@
+// Copyright:       Copyright (C) 2022 Doğa Can Yanıkoğlu
+// Source Code:     https://github.com/dyanikoglu/ALS-Community
+
+
+#include "Library/ALSLocomotionCore.h"
+
+#include <gtest/gtest.h>
+
+using namespace ALSLocomotionCore;
+
+TEST(ALSLocomotionCore, MapRangeClamped)
+{
+	EXPECT_FLOAT_EQ(MapRangeClamped(0.0f, 10.0f, 0.0f, 1.0f, 5.0f), 0.5f);
+	EXPECT_FLOAT_EQ(MapRangeClamped(0.0f, 10.0f, 0.0f, 1.0f, -5.0f), 0.0f);
+	EXPECT_FLOAT_EQ(MapRangeClamped(0.0f, 10.0f, 0.0f, 1.0f, 15.0f), 1.0f);
+	EXPECT_FLOAT_EQ(MapRangeClamped(10.0f, 0.0f, 0.0f, 1.0f, 2.5f), 0.75f);
+
+	// Empty input range picks one of the ends
+	EXPECT_FLOAT_EQ(MapRangeClamped(5.0f, 5.0f, 1.0f, 2.0f, 4.0f), 1.0f);
+	EXPECT_FLOAT_EQ(MapRangeClamped(5.0f, 5.0f, 1.0f, 2.0f, 5.0f), 2.0f);
+}
+
+TEST(ALSLocomotionCore, NormalizeAxis)
+{
+	EXPECT_FLOAT_EQ(NormalizeAxis(0.0f), 0.0f);
+	EXPECT_FLOAT_EQ(NormalizeAxis(180.0f), 180.0f);
+	EXPECT_FLOAT_EQ(NormalizeAxis(-180.0f), 180.0f);
+	EXPECT_FLOAT_EQ(NormalizeAxis(190.0f), -170.0f);
+	EXPECT_FLOAT_EQ(NormalizeAxis(-190.0f), 170.0f);
+	EXPECT_FLOAT_EQ(NormalizeAxis(720.0f + 45.0f), 45.0f);
+	EXPECT_FLOAT_EQ(NormalizeAxis(-720.0f - 45.0f), -45.0f);
+}
+
+TEST(ALSLocomotionCore, AngleInRange)
+{
+	EXPECT_TRUE(AngleInRange(72.0f, -70.0f, 70.0f, 5.0f, true));
+	EXPECT_FALSE(AngleInRange(72.0f, -70.0f, 70.0f, 5.0f, false));
+	EXPECT_TRUE(AngleInRange(64.0f, -70.0f, 70.0f, 5.0f, false));
+	EXPECT_FALSE(AngleInRange(-76.0f, -70.0f, 70.0f, 5.0f, true));
+}
+
+TEST(ALSLocomotionCore, CalculateQuadrant)
+{
+	auto Quadrant = [](EMovementDirection Current, float Angle)
+	{
+		return CalculateQuadrant(Current, 70.0f, -70.0f, 110.0f, -110.0f, 5.0f, Angle);
+	};
+
+	EXPECT_EQ(Quadrant(EMovementDirection::Forward, 0.0f), EMovementDirection::Forward);
+	EXPECT_EQ(Quadrant(EMovementDirection::Forward, 90.0f), EMovementDirection::Right);
+	EXPECT_EQ(Quadrant(EMovementDirection::Forward, -90.0f), EMovementDirection::Left);
+	EXPECT_EQ(Quadrant(EMovementDirection::Forward, 180.0f), EMovementDirection::Backward);
+
+	// The ranges of the other directions are widened by the buffer and the current one is narrowed, same as the ALS
+	// blueprints
+	EXPECT_EQ(Quadrant(EMovementDirection::Forward, 67.0f), EMovementDirection::Right);
+	EXPECT_EQ(Quadrant(EMovementDirection::Right, 73.0f), EMovementDirection::Forward);
+	EXPECT_EQ(Quadrant(EMovementDirection::Right, 112.0f), EMovementDirection::Backward);
+	EXPECT_EQ(Quadrant(EMovementDirection::Backward, 108.0f), EMovementDirection::Right);
+	EXPECT_EQ(Quadrant(EMovementDirection::Backward, -108.0f), EMovementDirection::Left);
+}
+
+TEST(ALSLocomotionCore, CalculateMovementDirection)
+{
+	EXPECT_EQ(CalculateMovementDirection(EMovementDirection::Left, EGait::Sprinting, ERotationMode::LookingDirection,
+	                                     -90.0f), EMovementDirection::Forward);
+	EXPECT_EQ(CalculateMovementDirection(EMovementDirection::Left, EGait::Running, ERotationMode::VelocityDirection,
+	                                     -90.0f), EMovementDirection::Forward);
+	EXPECT_EQ(CalculateMovementDirection(EMovementDirection::Forward, EGait::Running, ERotationMode::Aiming, -90.0f),
+	          EMovementDirection::Left);
+}
+
+TEST(ALSLocomotionCore, CanSprint)
+{
+	EXPECT_FALSE(CanSprint(false, 1.0f, ERotationMode::VelocityDirection, 0.0f));
+	EXPECT_FALSE(CanSprint(true, 1.0f, ERotationMode::Aiming, 0.0f));
+	EXPECT_FALSE(CanSprint(true, 0.5f, ERotationMode::VelocityDirection, 0.0f));
+	EXPECT_TRUE(CanSprint(true, 1.0f, ERotationMode::VelocityDirection, 120.0f));
+	EXPECT_TRUE(CanSprint(true, 1.0f, ERotationMode::LookingDirection, 45.0f));
+	EXPECT_FALSE(CanSprint(true, 1.0f, ERotationMode::LookingDirection, -55.0f));
+}
+
+TEST(ALSLocomotionCore, GetAllowedGait)
+{
+	EXPECT_EQ(GetAllowedGait(EStance::Standing, ERotationMode::LookingDirection, EGait::Sprinting, true),
+	          EGait::Sprinting);
+	EXPECT_EQ(GetAllowedGait(EStance::Standing, ERotationMode::LookingDirection, EGait::Sprinting, false),
+	          EGait::Running);
+	EXPECT_EQ(GetAllowedGait(EStance::Standing, ERotationMode::Aiming, EGait::Sprinting, true), EGait::Running);
+	EXPECT_EQ(GetAllowedGait(EStance::Crouching, ERotationMode::VelocityDirection, EGait::Sprinting, true),
+	          EGait::Running);
+	EXPECT_EQ(GetAllowedGait(EStance::Crouching, ERotationMode::VelocityDirection, EGait::Walking, true),
+	          EGait::Walking);
+}
+
+TEST(ALSLocomotionCore, GetActualGait)
+{
+	EXPECT_EQ(GetActualGait(EGait::Sprinting, 700.0f, 165.0f, 375.0f), EGait::Sprinting);
+	EXPECT_EQ(GetActualGait(EGait::Running, 700.0f, 165.0f, 375.0f), EGait::Running);
+	EXPECT_EQ(GetActualGait(EGait::Sprinting, 380.0f, 165.0f, 375.0f), EGait::Running);
+	EXPECT_EQ(GetActualGait(EGait::Running, 170.0f, 165.0f, 375.0f), EGait::Walking);
+}
+
+TEST(ALSLocomotionCore, GetMappedSpeed)
+{
+	EXPECT_FLOAT_EQ(GetMappedSpeed(0.0f, 165.0f, 375.0f, 650.0f), 0.0f);
+	EXPECT_FLOAT_EQ(GetMappedSpeed(165.0f, 165.0f, 375.0f, 650.0f), 1.0f);
+	EXPECT_FLOAT_EQ(GetMappedSpeed(270.0f, 165.0f, 375.0f, 650.0f), 1.5f);
+	EXPECT_FLOAT_EQ(GetMappedSpeed(375.0f, 165.0f, 375.0f, 650.0f), 2.0f);
+	EXPECT_FLOAT_EQ(GetMappedSpeed(1000.0f, 165.0f, 375.0f, 650.0f), 3.0f);
+}
+
+TEST(ALSLocomotionCore, CalculateGroundedRotationRate)
+{
+	EXPECT_FLOAT_EQ(CalculateGroundedRotationRate(2.0f, 0.0f), 2.0f);
+	EXPECT_FLOAT_EQ(CalculateGroundedRotationRate(2.0f, 150.0f), 4.0f);
+	EXPECT_FLOAT_EQ(CalculateGroundedRotationRate(2.0f, 600.0f), 6.0f);
+}
+
+TEST(ALSLocomotionCore, CalculateVelocityBlend)
+{
+	const FVelocityBlend Stopped = CalculateVelocityBlend(0.0f, 0.0f, 0.0f);
+	EXPECT_FLOAT_EQ(Stopped.F + Stopped.B + Stopped.L + Stopped.R, 0.0f);
+
+	const FVelocityBlend Forward = CalculateVelocityBlend(1.0f, 0.0f, 0.0f);
+	EXPECT_FLOAT_EQ(Forward.F, 1.0f);
+	EXPECT_FLOAT_EQ(Forward.B, 0.0f);
+
+	// Diagonals equal .5 for each direction
+	const float Diagonal = std::sqrt(0.5f);
+	const FVelocityBlend BackLeft = CalculateVelocityBlend(-Diagonal, -Diagonal, 0.0f);
+	EXPECT_FLOAT_EQ(BackLeft.B, 0.5f);
+	EXPECT_FLOAT_EQ(BackLeft.L, 0.5f);
+	EXPECT_FLOAT_EQ(BackLeft.F, 0.0f);
+	EXPECT_FLOAT_EQ(BackLeft.R, 0.0f);
+}